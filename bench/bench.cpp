@@ -0,0 +1,186 @@
+#include <benchmark/benchmark.h>
+#include "npc.h"
+#include "squirrel.h"
+#include "werewolf.h"
+#include "druid.h"
+#include "factory.h"
+#include "game.h"
+#include "world_file.h"
+#include "random.h"
+#include "range_query.h"
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cmath>
+
+static const int BENCH_LIMIT = 1000000;
+static const std::uint64_t BENCH_SEED = 42;
+
+static std::shared_ptr<NPC> random_npc(std::uint32_t i, int map_size,
+                                       const std::shared_ptr<NpcArena> &arena = nullptr) {
+    RandomStream rng(BENCH_SEED, RngPurpose::Spawn, 0, i);
+    NpcType type = static_cast<NpcType>(rng.uniform(SquirrelType, DruidType));
+    int x = rng.uniform(0, map_size - 1);
+    int y = rng.uniform(0, map_size - 1);
+    return factory(type, x, y, generate_name(BENCH_SEED, i), BENCH_LIMIT, arena);
+}
+
+static set_t random_set(size_t count, int map_size) {
+    set_t result;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        result.insert(random_npc(i, map_size));
+    }
+    return result;
+}
+
+static GameConfig bench_config(int npcs, int map_size) {
+    GameConfig config;
+    config.npc_count = npcs;
+    config.map_size = map_size;
+    config.headless = true;
+    config.seed = BENCH_SEED;
+    return config;
+}
+
+static void BM_IsClose(benchmark::State &state) {
+    std::vector<std::shared_ptr<NPC>> npcs;
+    for (std::uint32_t i = 0; i < 1024; ++i) {
+        npcs.push_back(random_npc(i, 1000));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(npcs[i & 1023]->is_close(npcs[(i + 1) & 1023], 50));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IsClose);
+
+static void BM_SelectClose(benchmark::State &state) {
+    RangeIsa isa = static_cast<RangeIsa>(state.range(0));
+    std::vector<int> xs(4096), ys(4096);
+    for (std::uint32_t i = 0; i < xs.size(); ++i) {
+        RandomStream rng(BENCH_SEED, RngPurpose::Spawn, 0, i);
+        xs[i] = rng.uniform(0, 999);
+        ys[i] = rng.uniform(0, 999);
+    }
+    std::vector<std::uint32_t> hits(xs.size());
+
+    for (auto _ : state) {
+        size_t n = select_close(isa, xs.data(), ys.data(), xs.size(), 500, 500, 50, hits.data());
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetLabel(range_isa_name(isa > range_isa() ? range_isa() : isa));
+    state.SetItemsProcessed(state.iterations() * xs.size());
+}
+BENCHMARK(BM_SelectClose)->DenseRange(0, 2);
+
+static void BM_Fight(benchmark::State &state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    // Keep density constant so the work per NPC is comparable across sizes.
+    int map_size = static_cast<int>(std::sqrt(static_cast<double>(count)) * 20);
+    set_t array = random_set(count, map_size);
+
+    for (auto _ : state) {
+        auto dead = fight(array, 20);
+        benchmark::DoNotOptimize(dead);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Fight)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveLoadText(benchmark::State &state) {
+    set_t array = random_set(static_cast<size_t>(state.range(0)), 500);
+    const std::string filename = "bench_npcs.txt";
+
+    for (auto _ : state) {
+        save(array, filename);
+        auto loaded = load(filename);
+        benchmark::DoNotOptimize(loaded);
+    }
+    state.SetItemsProcessed(state.iterations() * array.size());
+    std::remove(filename.c_str());
+}
+BENCHMARK(BM_SaveLoadText)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveLoadBinary(benchmark::State &state) {
+    set_t array = random_set(static_cast<size_t>(state.range(0)), 500);
+    const std::string filename = "bench_npcs.bin";
+
+    for (auto _ : state) {
+        save_binary(array, filename);
+        auto loaded = load(filename);
+        benchmark::DoNotOptimize(loaded);
+    }
+    state.SetItemsProcessed(state.iterations() * array.size());
+    std::remove(filename.c_str());
+}
+BENCHMARK(BM_SaveLoadBinary)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_Tick(benchmark::State &state) {
+    int npcs = static_cast<int>(state.range(0));
+    Game game(bench_config(npcs, static_cast<int>(std::sqrt(static_cast<double>(npcs)) * 100)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(game.step());
+    }
+    state.SetItemsProcessed(state.iterations() * npcs);
+}
+BENCHMARK(BM_Tick)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// Whole ticks, like BM_Tick, but on a map crowded enough that most Druids
+// have several opponents in reach, so fight resolution dominates; items are
+// fights resolved rather than NPCs.
+static void BM_CrowdedTick(benchmark::State &state) {
+    int npcs = static_cast<int>(state.range(0));
+    Game game(bench_config(npcs, static_cast<int>(std::sqrt(static_cast<double>(npcs)) * 5)));
+
+    size_t fights = 0;
+    for (auto _ : state) {
+        fights += game.step();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(fights));
+    state.counters["fights_per_tick"] = benchmark::Counter(
+        static_cast<double>(fights) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_CrowdedTick)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_Factory(benchmark::State &state) {
+    bool pooled = state.range(0) != 0;
+    const size_t batch = 10000;
+
+    for (auto _ : state) {
+        auto arena = pooled ? std::make_shared<NpcArena>() : nullptr;
+        std::vector<std::shared_ptr<NPC>> npcs;
+        npcs.reserve(batch);
+        for (std::uint32_t i = 0; i < batch; ++i) {
+            npcs.push_back(factory(static_cast<NpcType>(1 + i % 3), i % 500, i % 500, "Bench",
+                                   BENCH_LIMIT, arena));
+        }
+        benchmark::DoNotOptimize(npcs);
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+    state.SetLabel(pooled ? "arena" : "heap");
+}
+BENCHMARK(BM_Factory)->Arg(0)->Arg(1);
+
+int main(int argc, char **argv) {
+    set_kill_logging(false);
+
+    // JSON on stdout unless the caller picked a format explicitly.
+    std::vector<char *> args(argv, argv + argc);
+    std::string json = "--benchmark_format=json";
+    bool has_format = false;
+    for (int i = 1; i < argc; ++i) {
+        has_format |= std::string(argv[i]).rfind("--benchmark_format", 0) == 0;
+    }
+    if (!has_format) args.push_back(json.data());
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "config.h"
+#include "npc.h"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+struct RunResult {
+    std::uint64_t seed = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t fights = 0;
+    std::uint64_t survivors[NPC_TYPE_COUNT] = {};
+    std::uint64_t total = 0;
+};
+
+struct SpeciesStats {
+    NpcType type = Unknown;
+    double mean = 0;
+    double stddev = 0;
+    std::uint64_t min = 0;
+    std::uint64_t p10 = 0;
+    std::uint64_t p50 = 0;
+    std::uint64_t p90 = 0;
+    std::uint64_t max = 0;
+    double extinct = 0;
+};
+
+// Runs config.batch_runs independent headless games on a pool of
+// config.threads workers. Run i uses seed config.seed + i, so any row can be
+// replayed on its own with --seed. Each game gets a private event bus, name
+// table and single-threaded region pool; results come back in run order.
+std::vector<RunResult> run_batch(const GameConfig &config);
+std::uint64_t batch_ticks(const GameConfig &config);
+
+std::vector<SpeciesStats> summarize(const std::vector<RunResult> &results);
+
+void write_runs_csv(std::ostream &os, const std::vector<RunResult> &results);
+void write_summary_csv(std::ostream &os, const std::vector<SpeciesStats> &stats);
+
+#endif
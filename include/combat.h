@@ -0,0 +1,20 @@
+#ifndef COMBAT_H
+#define COMBAT_H
+
+#include "npc.h"
+
+constexpr int NPC_TYPE_COUNT = 4;
+
+// rows: attacker, columns: defender (Unknown, Squirrel, Werewolf, Druid)
+constexpr bool KILL_TABLE[NPC_TYPE_COUNT][NPC_TYPE_COUNT] = {
+    {false, false, false, false},
+    {false, false, true,  false},
+    {false, false, false, true },
+    {false, false, false, false},
+};
+
+constexpr bool can_kill(NpcType attacker, NpcType defender) {
+    return KILL_TABLE[attacker][defender];
+}
+
+#endif
\ No newline at end of file
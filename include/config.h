@@ -0,0 +1,31 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include "fight_queue.h"
+#include "random.h"
+#include "renderer.h"
+#include <string>
+#include <cstdint>
+
+struct GameConfig {
+    int map_size = 100;
+    int npc_count = 50;
+    int game_time = 30;
+    int tick_ms = 50;
+    std::uint64_t turbo_ticks = 0;
+    bool headless = false;
+    unsigned threads = 0;
+    std::uint64_t seed = random_seed();
+    size_t queue_capacity = 4096;
+    QueuePolicy queue_policy = QueuePolicy::Block;
+    std::string journal_path;
+    std::string metrics_path;
+    std::uint64_t batch_runs = 0;
+    std::string csv_path = "batch.csv";
+    Viewport viewport;
+};
+
+GameConfig parse_args(int argc, char *argv[], int first = 1);
+std::string usage();
+
+#endif
\ No newline at end of file
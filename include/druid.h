@@ -6,17 +6,14 @@
 
 class Druid : public NPC {
 public:
-    Druid(int x, int y, const std::string& name);
-    Druid(std::istream &is);
+    Druid(int x, int y, std::string_view name, int limit = DEFAULT_COORDINATE_LIMIT,
+          NameTable &names = NameTable::global());
+    Druid(std::istream &is, int limit = DEFAULT_COORDINATE_LIMIT);
 
     void print() override;
     void save(std::ostream &os) override;
 
     bool accept(std::shared_ptr<NPCVisitor> visitor) override;
-    
-    bool fight(std::shared_ptr<Squirrel> other) override;
-    bool fight(std::shared_ptr<Werewolf> other) override;
-    bool fight(std::shared_ptr<Druid> other) override;
 
     int get_move_distance() const override;
     int get_kill_distance() const override;
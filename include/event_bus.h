@@ -0,0 +1,58 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <memory>
+#include <vector>
+#include <shared_mutex>
+#include <atomic>
+#include <cstddef>
+
+class NPC;
+
+enum class EventKind {
+    Fight,
+    Kill
+};
+
+struct FightNotice {
+    const NPC *attacker;
+    const NPC *defender;
+    bool win;
+};
+
+class IFightObserver {
+public:
+    virtual ~IFightObserver() = default;
+    virtual void on_fights(const FightNotice *notices, size_t count) = 0;
+};
+
+class EventBus {
+public:
+    using subscription_t = size_t;
+
+private:
+    struct Subscription {
+        subscription_t id;
+        EventKind kind;
+        std::shared_ptr<IFightObserver> observer;
+    };
+
+    mutable std::shared_mutex mutex;
+    std::vector<Subscription> subscriptions;
+    subscription_t next_id{1};
+    std::atomic<size_t> fight_subscribers{0};
+    std::atomic<size_t> kill_subscribers{0};
+
+public:
+    static EventBus &global();
+
+    subscription_t subscribe(EventKind kind, std::shared_ptr<IFightObserver> observer);
+    void unsubscribe(subscription_t id);
+
+    bool wants(EventKind kind) const;
+
+    void publish(const FightNotice *notices, size_t count);
+    void publish(const FightNotice &notice);
+};
+
+#endif
\ No newline at end of file
@@ -3,14 +3,25 @@
 
 #include "npc.h"
 #include "visitor.h"
+#include "npc_arena.h"
 #include <memory>
-#include <random>
+#include <cstdint>
 
-std::shared_ptr<NPC> factory(NpcType type, int x, int y, const std::string& name);
-std::shared_ptr<NPC> factory(std::istream &is);
+std::shared_ptr<NPC> factory(NpcType type, int x, int y, std::string_view name,
+                             int limit = NPC::DEFAULT_COORDINATE_LIMIT,
+                             const std::shared_ptr<NpcArena> &arena = nullptr,
+                             NameTable &names = NameTable::global());
+std::shared_ptr<NPC> factory(std::istream &is, int limit = NPC::DEFAULT_COORDINATE_LIMIT,
+                             const std::shared_ptr<NpcArena> &arena = nullptr);
+size_t npc_arena_bytes(size_t count);
 void save(const set_t &array, const std::string &filename);
-set_t load(const std::string &filename);
+set_t load(const std::string &filename, int limit = NPC::MAX_COORDINATE_LIMIT);
 set_t fight(const set_t &array, size_t distance);
-std::string generate_name();
+void flush_logs();
+void set_kill_logging(bool enabled);
+void set_console_logging(bool enabled);
+std::string_view generate_name();
+std::string_view generate_name(std::uint64_t seed, std::uint32_t id,
+                               NameTable &table = NameTable::global());
 
 #endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef FIGHT_QUEUE_H
+#define FIGHT_QUEUE_H
+
+#include "world.h"
+#include "ring_buffer.h"
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+struct Fight {
+    World::index_t attacker;
+    World::index_t defender;
+    std::uint32_t tick;
+};
+
+enum class QueuePolicy {
+    Block,
+    DropOldest,
+    DropNewest
+};
+
+struct FightQueueStats {
+    std::uint64_t enqueued;
+    std::uint64_t dropped;
+};
+
+class FightQueue {
+private:
+    RingBuffer<Fight> ring;
+    QueuePolicy policy;
+
+    std::vector<Fight> evicted;
+
+    std::atomic<std::uint64_t> enqueued{0};
+    std::atomic<std::uint64_t> dropped{0};
+
+public:
+    FightQueue(size_t capacity, QueuePolicy policy);
+
+    // Returns how many more fights drain() will hand out because of this
+    // call: fights pushed minus fights evicted to make room for them.
+    size_t publish(const std::vector<Fight> &fights, const std::atomic<bool> &running);
+    size_t drain(Fight *out, size_t max_count);
+
+    bool empty() const;
+    size_t size() const;
+    size_t capacity() const;
+    QueuePolicy get_policy() const;
+    FightQueueStats stats() const;
+};
+
+#endif
\ No newline at end of file
@@ -2,52 +2,139 @@
 #define GAME_H
 
 #include "factory.h"
+#include "config.h"
+#include "world.h"
+#include "grid.h"
+#include "fight_queue.h"
+#include "thread_pool.h"
+#include "random.h"
+#include "journal.h"
+#include "event_bus.h"
+#include "snapshot.h"
+#include "renderer.h"
+#include "metrics.h"
+#include "scheduler.h"
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <atomic>
 #include <thread>
-#include <queue>
 #include <condition_variable>
+#include <cstdint>
 
 class Game {
 private:
-    static const int MAP_SIZE = 100;
-    static const int NPC_COUNT = 50;
-    static const int GAME_TIME = 30;
+    static const size_t FIGHT_BATCH = 256;
+    static const int MAX_REGIONS = 16;
+    static const int TILE_SIZE = 64;
+    static const int MAX_VIEW_COLS = 160;
+    static const int MAX_VIEW_ROWS = 50;
+    static const size_t COMPACT_RATIO = 8;
+    static const std::uint64_t MAX_CATCH_UP = 5;
+    static constexpr std::chrono::seconds REPORT_INTERVAL{1};
 
-    set_t npcs;
-    std::shared_mutex npcs_mutex;
+    GameConfig config;
+    std::uint64_t seed;
+    std::uint32_t tick{0};
+    EventBus &bus;
+    NameTable &names;
+
+    std::shared_ptr<NpcArena> arena;
+    World world;
+    SpatialGrid spatial_grid;
     
     std::atomic<bool> running;
     std::thread move_thread;
     std::thread fight_thread;
     
-    struct Fight {
-        std::shared_ptr<NPC> attacker;
-        std::shared_ptr<NPC> defender;
-    };
-    std::queue<Fight> fight_queue;
+    FightQueue fight_queue;
+    std::vector<Fight> pending_fights;
     std::mutex queue_mutex;
     std::condition_variable queue_cv;
+    std::condition_variable idle_cv;
+    size_t fights_in_flight{0};
+    bool fight_busy{false};
+
+    struct TickLog {
+        std::vector<FightEvent> events;
+        std::vector<FightNotice> notices;
+        std::vector<World::index_t> killed;
+        std::uint64_t resolved{0};
+        std::uint64_t kills[NPC_TYPE_COUNT] = {};
+        std::uint64_t cout_waits{0};
+        std::uint64_t cout_wait_ns{0};
+    };
+
+    struct Region {
+        int first_col;
+        int last_col;
+        std::vector<SpatialGrid::tile_id> tiles;
+        std::vector<World::index_t> migrations;
+        std::vector<Fight> handoff;
+        std::vector<std::uint32_t> hits;
+        size_t fights{0};
+        TickLog log;
+    };
+
+    ThreadPool pool;
+    std::vector<Region> regions;
     
+    std::vector<World::index_t> remap;
+
+    std::unique_ptr<JournalWriter> journal;
+    TickLog handoff_log;
+    bool notify_fights{false};
+    bool notify_kills{false};
+
+    SnapshotBuffer snapshots;
+    std::unique_ptr<MapRenderer> renderer;
+    // When print_map next draws; ticks only capture a snapshot close to it.
+    std::atomic<std::chrono::steady_clock::time_point> next_frame{std::chrono::steady_clock::time_point()};
+
+    Metrics metrics;
+    std::unique_ptr<MetricsExporter> exporter;
+
     std::mutex cout_mutex;
 
+    size_t run_tick(bool inline_fights);
+    void stop();
+    void run_realtime();
+    void run_turbo();
     void move_worker();
     void fight_worker();
     
+    void publish_fights();
     void create_npcs();
-    void move_npc(std::shared_ptr<NPC> npc);
-    bool process_fight(std::shared_ptr<NPC> attacker, std::shared_ptr<NPC> defender);
+    void create_regions();
+    void assign_tiles();
+    bool owns(const Region &region, World::index_t index) const;
+    void move_region(Region &region);
+    void fight_region(Region &region);
+    void move_npc(Region &region, World::index_t index);
+    bool process_fight(const Fight &fight, TickLog &log);
+    void account(TickLog &log, ThreadMetrics &m);
+    void deliver_tick();
+    void retire_killed(TickLog &log);
+    void publish_snapshot();
+    bool frame_due() const;
+    void compact_world();
     void print_map();
     void print_survivors();
+    void print_queue_stats();
+    void export_metrics();
+    void print_metrics_summary();
 
 public:
-    Game();
+    explicit Game(const GameConfig &config = GameConfig(), EventBus &bus = EventBus::global(),
+                  NameTable &names = NameTable::global());
     ~Game();
     
     void run();
+    size_t step();
+    MetricsSnapshot collect_metrics() const;
+    std::uint64_t get_seed() const;
+    size_t survivors(NpcType type) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include "world.h"
+#include "range_query.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+
+// Sparse grid of square tiles over a 32-bit map. A tile exists only while
+// something stands on it and keeps its members' coordinates contiguous for
+// select_close. Tiles holding an active NPC (one that moves or attacks) are
+// awake; the rest sleep and are never visited by the tick.
+class SpatialGrid {
+public:
+    using tile_id = std::uint32_t;
+
+    struct Tile {
+        int tx = 0;
+        int ty = 0;
+        std::vector<World::index_t> members;
+        std::vector<int> xs;
+        std::vector<int> ys;
+        std::uint32_t active = 0;
+        std::uint32_t awake_slot = NO_SLOT;
+    };
+
+private:
+    static constexpr std::uint32_t NO_SLOT = UINT32_MAX;
+
+    int map_size;
+    int cell_size;
+    int cols;
+
+    std::vector<Tile> tiles;
+    std::vector<tile_id> free_tiles;
+    std::unordered_map<std::uint64_t, tile_id> tile_ids;
+    std::vector<tile_id> awake;
+
+    // Indexed by World::index_t.
+    std::vector<tile_id> tile_of;
+    std::vector<std::uint32_t> slot_of;
+    std::vector<std::uint8_t> active_of;
+
+    int cell_coord(long long v) const;
+    static std::uint64_t key(int tx, int ty);
+    const Tile *find(int tx, int ty) const;
+
+    tile_id acquire(int tx, int ty);
+    void release(tile_id t);
+    void set_awake(tile_id t, bool on);
+    void attach(World::index_t index, tile_id t, int x, int y);
+    void detach(World::index_t index);
+
+public:
+    SpatialGrid(int map_size, int cell_size);
+
+    void insert(World::index_t index, int x, int y, bool active = false);
+    void move(World::index_t index, int new_x, int new_y);
+    void deactivate(World::index_t index);
+    void remap(const std::vector<World::index_t> &new_index);
+    void clear();
+
+    int get_cell_size() const;
+    int get_cols() const;
+    int column_of(int x) const;
+
+    size_t tile_count() const { return tile_ids.size(); }
+    const std::vector<tile_id> &awake_tiles() const { return awake; }
+    const Tile &tile(tile_id t) const { return tiles[t]; }
+
+    template <typename F>
+    void for_each_near(int x, int y, int radius, F &&f) const {
+        int min_cx = cell_coord(x - static_cast<long long>(radius));
+        int max_cx = cell_coord(x + static_cast<long long>(radius));
+        int min_cy = cell_coord(y - static_cast<long long>(radius));
+        int max_cy = cell_coord(y + static_cast<long long>(radius));
+
+        for (int cy = min_cy; cy <= max_cy; ++cy) {
+            for (int cx = min_cx; cx <= max_cx; ++cx) {
+                const Tile *t = find(cx, cy);
+                if (!t) continue;
+                for (World::index_t index : t->members) {
+                    f(index);
+                }
+            }
+        }
+    }
+
+    // Visits the members within `radius` of (x, y) in for_each_near order.
+    template <typename F>
+    void for_each_close(int x, int y, int radius, std::vector<std::uint32_t> &hits, F &&f) const {
+        int min_cx = cell_coord(x - static_cast<long long>(radius));
+        int max_cx = cell_coord(x + static_cast<long long>(radius));
+        int min_cy = cell_coord(y - static_cast<long long>(radius));
+        int max_cy = cell_coord(y + static_cast<long long>(radius));
+
+        for (int cy = min_cy; cy <= max_cy; ++cy) {
+            for (int cx = min_cx; cx <= max_cx; ++cx) {
+                const Tile *t = find(cx, cy);
+                if (!t) continue;
+
+                size_t count = t->members.size();
+                if (hits.size() < count) hits.resize(count);
+                size_t n = select_close(t->xs.data(), t->ys.data(), count, x, y, radius, hits.data());
+                for (size_t k = 0; k < n; ++k) {
+                    f(t->members[hits[k]]);
+                }
+            }
+        }
+    }
+};
+
+#endif
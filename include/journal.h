@@ -0,0 +1,78 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "mapped_file.h"
+#include <cstdint>
+#include <string>
+#include <fstream>
+#include <vector>
+
+constexpr char JOURNAL_MAGIC[4] = {'N', 'P', 'C', 'J'};
+constexpr std::uint32_t JOURNAL_VERSION = 1;
+
+enum class FightOutcome : std::uint8_t {
+    Immune = 0,
+    Missed = 1,
+    Killed = 2
+};
+
+struct JournalHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint32_t reserved;
+};
+
+struct FightEvent {
+    std::uint32_t tick;
+    std::uint32_t attacker_id;
+    std::uint32_t defender_id;
+    std::uint8_t attacker_type;
+    std::uint8_t defender_type;
+    std::uint8_t attack_roll;
+    std::uint8_t defense_roll;
+    std::int32_t attacker_x;
+    std::int32_t attacker_y;
+    std::int32_t defender_x;
+    std::int32_t defender_y;
+    FightOutcome outcome;
+    std::uint8_t reserved[3];
+};
+
+static_assert(sizeof(FightEvent) == 36, "FightEvent must stay a fixed 36-byte record");
+
+class JournalWriter {
+private:
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    std::ofstream file;
+    std::vector<char> buffer;
+    std::uint64_t written{0};
+
+public:
+    explicit JournalWriter(const std::string &filename);
+    ~JournalWriter();
+
+    void append(const FightEvent *events, size_t count);
+    void flush();
+    std::uint64_t count() const;
+};
+
+class JournalReader {
+private:
+    MappedFile file;
+    const FightEvent *events{nullptr};
+    size_t count{0};
+
+public:
+    explicit JournalReader(const std::string &filename);
+
+    size_t size() const;
+    const FightEvent *begin() const;
+    const FightEvent *end() const;
+    const FightEvent &operator[](size_t i) const;
+};
+
+const char *outcome_name(FightOutcome outcome);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+#include "npc.h"
+#include "ring_buffer.h"
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+struct KillRecord {
+    NpcType attacker_type;
+    int attacker_x;
+    int attacker_y;
+    std::string_view attacker_name;
+    NpcType defender_type;
+    int defender_x;
+    int defender_y;
+    std::string_view defender_name;
+};
+
+KillRecord make_kill_record(const NPC &attacker, const NPC &defender);
+
+class LogSink {
+public:
+    using formatter = void (*)(std::string &out, const KillRecord &record);
+
+private:
+    static const size_t BATCH = 256;
+
+    std::ostream &out;
+    formatter format;
+    RingBuffer<KillRecord> queue;
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> sleeping{false};
+    std::atomic<std::uint64_t> posted{0};
+    std::uint64_t written{0};
+
+    std::mutex mutex;
+    std::condition_variable wake_cv;
+    std::condition_variable written_cv;
+    std::thread thread;
+
+    void worker();
+
+public:
+    LogSink(std::ostream &out, formatter format, size_t capacity = 8192);
+    ~LogSink();
+
+    LogSink(const LogSink &) = delete;
+    LogSink &operator=(const LogSink &) = delete;
+
+    void post(const KillRecord &record);
+    void flush();
+};
+
+#endif
\ No newline at end of file
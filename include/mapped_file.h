@@ -0,0 +1,31 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+class MappedFile {
+private:
+    const char *bytes{nullptr};
+    size_t length{0};
+#ifdef _WIN32
+    void *file_handle{nullptr};
+    void *mapping_handle{nullptr};
+#else
+    int fd{-1};
+#endif
+
+    void unmap();
+
+public:
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const;
+    size_t size() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "combat.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+using metrics_clock = std::chrono::steady_clock;
+
+// Counters have a single writing thread, so updates are plain relaxed
+// load/store pairs; readers aggregate them without stopping the writers.
+inline void bump(std::atomic<std::uint64_t> &counter, std::uint64_t value = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline std::uint64_t elapsed_ns(metrics_clock::time_point since) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(metrics_clock::now() - since).count());
+}
+
+enum LockId {
+    QueueLock,
+    CoutLock,
+    LOCK_COUNT
+};
+
+const char *lock_name(LockId lock);
+
+struct HistogramSnapshot {
+    // Bucket i counts samples up to 2^i microseconds; the last one is +Inf.
+    static const int BUCKETS = 24;
+
+    std::uint64_t counts[BUCKETS] = {};
+    std::uint64_t count = 0;
+    std::uint64_t sum_us = 0;
+
+    static std::uint64_t upper_bound(int bucket);
+    std::uint64_t percentile(double q) const;
+};
+
+class Histogram {
+private:
+    std::atomic<std::uint64_t> counts[HistogramSnapshot::BUCKETS] = {};
+    std::atomic<std::uint64_t> sum_us{0};
+
+public:
+    void record_ns(std::uint64_t ns);
+    void merge_into(HistogramSnapshot &out) const;
+};
+
+struct alignas(64) ThreadMetrics {
+    Histogram tick_time;
+    Histogram render_time;
+    std::atomic<std::uint64_t> ticks{0};
+    std::atomic<std::uint64_t> ticks_skipped{0};
+    std::atomic<std::uint64_t> fights_resolved{0};
+    std::atomic<std::uint64_t> kills[NPC_TYPE_COUNT] = {};
+    std::atomic<std::uint64_t> queue_depth{0};
+    std::atomic<std::uint64_t> queue_depth_max{0};
+    std::atomic<std::uint64_t> lock_waits[LOCK_COUNT] = {};
+    std::atomic<std::uint64_t> lock_wait_ns[LOCK_COUNT] = {};
+
+    void record_wait(LockId lock, std::uint64_t ns) {
+        bump(lock_waits[lock]);
+        bump(lock_wait_ns[lock], ns);
+    }
+};
+
+struct MetricsSnapshot {
+    double uptime_s = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t ticks_skipped = 0;
+    HistogramSnapshot tick_time;
+    HistogramSnapshot render_time;
+    std::uint64_t fights_resolved = 0;
+    std::uint64_t kills[NPC_TYPE_COUNT] = {};
+    std::uint64_t queue_depth = 0;
+    std::uint64_t queue_depth_max = 0;
+    std::uint64_t enqueued = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t lock_waits[LOCK_COUNT] = {};
+    std::uint64_t lock_wait_ns[LOCK_COUNT] = {};
+    double enqueue_rate = 0;
+    double resolve_rate = 0;
+};
+
+class Metrics {
+public:
+    enum Slot {
+        MoveSlot,
+        FightSlot,
+        MainSlot,
+        SLOT_COUNT
+    };
+
+private:
+    ThreadMetrics slots[SLOT_COUNT];
+    metrics_clock::time_point started{metrics_clock::now()};
+
+public:
+    ThreadMetrics &slot(Slot s) { return slots[s]; }
+    MetricsSnapshot collect() const;
+};
+
+// Rewrites a Prometheus text file, or JSON when the path ends in ".json",
+// through a temporary file so readers never see a partial write.
+class MetricsExporter {
+private:
+    std::string path;
+    bool json;
+    MetricsSnapshot previous;
+
+public:
+    explicit MetricsExporter(const std::string &path);
+
+    void write(MetricsSnapshot &current);
+};
+
+std::string format_prometheus(const MetricsSnapshot &m);
+std::string format_json(const MetricsSnapshot &m);
+std::string format_summary(const MetricsSnapshot &m);
+
+#endif
\ No newline at end of file
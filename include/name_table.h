@@ -0,0 +1,35 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <shared_mutex>
+#include <cstdint>
+
+class NameTable {
+public:
+    using name_id = std::uint32_t;
+
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    mutable std::shared_mutex mutex;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *current{nullptr};
+    size_t block_used{BLOCK_SIZE};
+    std::vector<std::string_view> names;
+    std::unordered_map<std::string_view, name_id> ids;
+
+    std::string_view store(std::string_view name);
+
+public:
+    static NameTable &global();
+
+    name_id intern(std::string_view name);
+    std::string_view get(name_id id) const;
+    size_t size() const;
+};
+
+#endif
\ No newline at end of file
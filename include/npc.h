@@ -5,15 +5,17 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <set>
 #include <cmath>
 #include <stdexcept>
+#include <cstdint>
+#include "name_table.h"
 
 class Squirrel;
 class Werewolf;
 class Druid;
-class IFightObserver;
 class NPCVisitor;
 
 using set_t = std::set<std::shared_ptr<class NPC>>;
@@ -25,36 +27,32 @@ enum NpcType {
     DruidType = 3
 };
 
-class IFightObserver {
-public:
-    virtual ~IFightObserver() = default;
-    virtual void on_fight(const std::shared_ptr<class NPC> attacker, 
-                         const std::shared_ptr<class NPC> defender, 
-                         bool win) = 0;
-};
-
 class NPC : public std::enable_shared_from_this<NPC> {
 protected:
     NpcType type;
     int x{0};
     int y{0};
-    std::string name;
+    NameTable::name_id name_id;
+    std::string_view name;
     bool alive;
-    std::vector<std::shared_ptr<IFightObserver>> observers;
+
+    bool fight_with(const std::shared_ptr<NPC> &other);
 
 public:
-    NPC(NpcType t, int _x, int _y, const std::string& _name);
-    NPC(NpcType t, std::istream &is);
-    virtual ~NPC() = default;
+    static const int DEFAULT_COORDINATE_LIMIT = 500;
+    // Largest coordinate a saved world may hold, in either file format.
+    static const int MAX_COORDINATE_LIMIT = INT32_MAX;
 
-    void subscribe(std::shared_ptr<IFightObserver> observer);
-    void fight_notify(const std::shared_ptr<NPC> defender, bool win);
+    NPC(NpcType t, int _x, int _y, std::string_view _name, int limit = DEFAULT_COORDINATE_LIMIT,
+        NameTable &names = NameTable::global());
+    NPC(NpcType t, std::istream &is, int limit = DEFAULT_COORDINATE_LIMIT);
+    virtual ~NPC() = default;
 
     virtual bool accept(std::shared_ptr<NPCVisitor> visitor) = 0;
     
-    virtual bool fight(std::shared_ptr<Squirrel> other) = 0;
-    virtual bool fight(std::shared_ptr<Werewolf> other) = 0;
-    virtual bool fight(std::shared_ptr<Druid> other) = 0;
+    virtual bool fight(std::shared_ptr<Squirrel> other);
+    virtual bool fight(std::shared_ptr<Werewolf> other);
+    virtual bool fight(std::shared_ptr<Druid> other);
 
     bool is_close(const std::shared_ptr<NPC> &other, size_t distance) const;
     
@@ -68,7 +66,8 @@ public:
     NpcType get_type() const;
     int get_x() const;
     int get_y() const;
-    std::string get_name() const;
+    std::string_view get_name() const;
+    NameTable::name_id get_name_id() const;
     
     virtual void print() = 0;
     virtual void save(std::ostream &os);
@@ -0,0 +1,77 @@
+#ifndef NPC_ARENA_H
+#define NPC_ARENA_H
+
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+#include <utility>
+
+// Bump allocator for NPC objects. Freed objects go onto a per-size free list
+// and are reused by later spawns; blocks are only returned to the system
+// together, when the last allocator copy goes away.
+class NpcArena {
+private:
+    static const size_t BLOCK_SIZE = 1 << 20;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte *current{nullptr};
+    size_t block_size{0};
+    size_t used{0};
+    size_t allocated{0};
+    std::vector<std::pair<size_t, std::vector<void *>>> free_lists;
+
+public:
+    explicit NpcArena(size_t reserve_bytes = 0);
+
+    NpcArena(const NpcArena &) = delete;
+    NpcArena &operator=(const NpcArena &) = delete;
+
+    void *allocate(size_t bytes, size_t alignment);
+    void deallocate(void *p, size_t bytes);
+    size_t bytes_allocated();
+    size_t block_count();
+};
+
+template <typename T>
+class ArenaAllocator {
+private:
+    template <typename U> friend class ArenaAllocator;
+    std::shared_ptr<NpcArena> arena;
+
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<NpcArena> arena) : arena(std::move(arena)) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, size_t n) {
+        arena->deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const { return arena == other.arena; }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const { return arena != other.arena; }
+};
+
+// Bytes one std::allocate_shared<T> through ArenaAllocator<T> takes from
+// the arena: T and the shared_ptr control block share one allocation whose
+// layout is up to the standard library, so build one T from `args` in a
+// scratch arena and read back what it asked for.
+template <typename T, typename... Args>
+size_t arena_footprint(Args &&...args) {
+    auto probe = std::make_shared<NpcArena>(4 * sizeof(T));
+    auto object = std::allocate_shared<T>(ArenaAllocator<T>(probe), std::forward<Args>(args)...);
+    return probe->bytes_allocated();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef NPC_STREAM_H
+#define NPC_STREAM_H
+
+#include "npc.h"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+struct NpcEntry {
+    NpcType type;
+    int x;
+    int y;
+    std::string_view name;
+};
+
+struct StreamResult {
+    size_t expected;
+    size_t loaded;
+    size_t errors;
+};
+
+using npc_callback = std::function<void(const NpcEntry &)>;
+
+constexpr size_t STREAM_CHUNK_SIZE = 4 << 20;
+
+StreamResult stream_npcs(const std::string &filename, const npc_callback &callback,
+                         size_t threads = std::thread::hardware_concurrency(),
+                         size_t chunk_size = STREAM_CHUNK_SIZE);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <array>
+#include <cstdint>
+
+enum class RngPurpose : std::uint32_t {
+    Spawn = 1,
+    Move = 2,
+    Fight = 3,
+    Name = 4
+};
+
+class RandomStream {
+private:
+    std::array<std::uint32_t, 4> counter;
+    std::array<std::uint32_t, 2> key;
+    std::array<std::uint32_t, 4> block{};
+    int used{4};
+
+    void refill();
+
+public:
+    RandomStream(std::uint64_t seed, RngPurpose purpose,
+                 std::uint32_t tick, std::uint32_t a, std::uint32_t b = 0);
+
+    std::uint32_t next();
+    int uniform(int lo, int hi);
+};
+
+std::uint64_t random_seed();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef RANGE_QUERY_H
+#define RANGE_QUERY_H
+
+#include <cstddef>
+#include <cstdint>
+
+enum class RangeIsa {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// Best kernel the running CPU supports; probed once on first use.
+RangeIsa range_isa();
+const char *range_isa_name(RangeIsa isa);
+
+// Writes to `out` the offsets i in [0, count) whose point (xs[i], ys[i]) lies
+// within `radius` of (x, y), in ascending order, and returns how many were
+// written. `out` must have room for `count` entries. Coordinate differences
+// must fit in an int; squares are compared in 64 bits, so every kernel
+// agrees with the scalar one bit for bit.
+size_t select_close(const int *xs, const int *ys, size_t count,
+                    int x, int y, int radius, std::uint32_t *out);
+size_t select_close(RangeIsa isa, const int *xs, const int *ys, size_t count,
+                    int x, int y, int radius, std::uint32_t *out);
+
+inline bool within(int ax, int ay, int bx, int by, int radius) {
+    long long dx = static_cast<long long>(ax) - bx;
+    long long dy = static_cast<long long>(ay) - by;
+    return dx * dx + dy * dy <= static_cast<long long>(radius) * radius;
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "snapshot.h"
+#include <string>
+#include <vector>
+
+struct Viewport {
+    int x = 0;
+    int y = 0;
+    int cols = 0;
+    int rows = 0;
+    int zoom = 10;
+};
+
+// Keeps the last frame and emits only the cells that changed, as ANSI
+// cursor moves followed by the new symbols.
+class MapRenderer {
+private:
+    Viewport view;
+    std::vector<char> previous;
+    std::vector<char> current;
+    size_t previous_alive{0};
+    bool first_frame{true};
+    std::string frame;
+
+    void rasterize(const WorldSnapshot &snapshot);
+    void move_cursor(int row, int col);
+
+public:
+    explicit MapRenderer(const Viewport &view);
+
+    const std::string &render(const WorldSnapshot &snapshot);
+    const Viewport &viewport() const;
+};
+
+char npc_symbol(NpcType type);
+
+#endif
\ No newline at end of file
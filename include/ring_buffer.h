@@ -0,0 +1,117 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T>
+class RingBuffer {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+    alignas(64) std::atomic<size_t> dequeue_pos{0};
+
+    static size_t round_up(size_t capacity) {
+        size_t result = 2;
+        while (result < capacity) result <<= 1;
+        return result;
+    }
+
+public:
+    explicit RingBuffer(size_t capacity)
+        : cells(new Cell[round_up(capacity)]), mask(round_up(capacity) - 1)
+    {
+        for (size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    size_t push_batch(const T *items, size_t count) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t n = 0;
+            while (n < count &&
+                   cells[(pos + n) & mask].sequence.load(std::memory_order_acquire) == pos + n) {
+                ++n;
+            }
+
+            if (n == 0) {
+                size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::intptr_t>(seq - pos) < 0) return 0;
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (enqueue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                for (size_t k = 0; k < n; ++k) {
+                    Cell &cell = cells[(pos + k) & mask];
+                    cell.value = items[k];
+                    cell.sequence.store(pos + k + 1, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+    }
+
+    size_t pop_batch(T *out, size_t max_count) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t n = 0;
+            while (n < max_count &&
+                   cells[(pos + n) & mask].sequence.load(std::memory_order_acquire) == pos + n + 1) {
+                ++n;
+            }
+
+            if (n == 0) {
+                size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::intptr_t>(seq - (pos + 1)) < 0) return 0;
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (dequeue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                for (size_t k = 0; k < n; ++k) {
+                    Cell &cell = cells[(pos + k) & mask];
+                    out[k] = cell.value;
+                    cell.sequence.store(pos + k + mask + 1, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+    }
+
+    bool push(const T &value) {
+        return push_batch(&value, 1) == 1;
+    }
+
+    bool pop(T &value) {
+        return pop_batch(&value, 1) == 1;
+    }
+
+    size_t size() const {
+        size_t head = dequeue_pos.load(std::memory_order_acquire);
+        size_t tail = enqueue_pos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_t capacity() const {
+        return mask + 1;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
+// Fixed-timestep pacing against the wall clock. Tick k is due at
+// origin + k * step; a caller that falls behind runs up to max_catch_up
+// ticks back-to-back and the rest of the backlog is skipped.
+class TickScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+private:
+    static constexpr std::chrono::milliseconds WAIT_SLICE{50};
+
+    clock::duration step;
+    std::uint64_t max_catch_up;
+    clock::time_point origin;
+    std::uint64_t scheduled{0};
+    std::uint64_t skipped_ticks{0};
+
+    std::uint64_t due(clock::time_point now) const;
+
+public:
+    TickScheduler(clock::duration step, std::uint64_t max_catch_up,
+                  clock::time_point origin = clock::now());
+
+    std::uint64_t wait(const std::atomic<bool> &running);
+    std::uint64_t poll(clock::time_point now);
+
+    clock::time_point next_deadline() const;
+    std::uint64_t skipped() const;
+};
+
+#endif
\ No newline at end of file
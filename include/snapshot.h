@@ -0,0 +1,40 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "npc.h"
+#include "combat.h"
+#include "name_table.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+struct WorldSnapshot {
+    std::uint64_t epoch{0};
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<NpcType> types;
+    std::vector<std::uint8_t> alive_flags;
+    std::vector<NameTable::name_id> name_ids;
+    size_t alive{0};
+    size_t alive_by_type[NPC_TYPE_COUNT] = {};
+
+    size_t size() const { return xs.size(); }
+};
+
+// Two-slot publication: the writer fills the slot readers are not using and
+// swaps it in. A slot still pinned by a slow reader is replaced, not reused.
+class SnapshotBuffer {
+private:
+    std::shared_ptr<WorldSnapshot> front;
+    std::shared_ptr<WorldSnapshot> back;
+
+public:
+    SnapshotBuffer();
+
+    WorldSnapshot &begin_write();
+    void publish();
+
+    std::shared_ptr<const WorldSnapshot> acquire() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+
+    const std::function<void(size_t)> *job{nullptr};
+    size_t job_count{0};
+    std::atomic<size_t> next_task{0};
+    size_t busy{0};
+    size_t generation{0};
+    bool stopping{false};
+
+    void worker_loop();
+    void run_tasks(const std::function<void(size_t)> &fn, size_t count);
+
+public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const;
+    void run(size_t count, const std::function<void(size_t)> &fn);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "npc.h"
+#include "snapshot.h"
+#include "combat.h"
+#include "range_query.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <atomic>
+
+class World {
+public:
+    using index_t = std::uint32_t;
+    static constexpr index_t INVALID_INDEX = UINT32_MAX;
+
+private:
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<NpcType> types;
+    std::vector<std::uint8_t> alive_flags;
+    std::vector<int> move_distances;
+    std::vector<int> kill_distances;
+    std::vector<std::uint32_t> ids;
+    std::vector<NameTable::name_id> name_ids;
+    std::vector<std::shared_ptr<NPC>> handles;
+    std::uint32_t next_id{0};
+    std::atomic<size_t> alive_total{0};
+    std::atomic<size_t> alive_by_type[NPC_TYPE_COUNT] = {};
+
+public:
+    index_t add(const std::shared_ptr<NPC> &npc);
+    void reserve(size_t count);
+    void clear();
+
+    void set_position(index_t i, int x, int y);
+    void kill(index_t i);
+
+    size_t compact(std::vector<index_t> &remap);
+
+    void capture(WorldSnapshot &out, std::uint64_t epoch) const;
+
+    size_t size() const { return xs.size(); }
+    bool empty() const { return xs.empty(); }
+    size_t alive() const { return alive_total.load(std::memory_order_relaxed); }
+    size_t alive(NpcType t) const { return alive_by_type[t].load(std::memory_order_relaxed); }
+    size_t dead() const { return size() - alive(); }
+
+    int x(index_t i) const { return xs[i]; }
+    int y(index_t i) const { return ys[i]; }
+    NpcType type(index_t i) const { return types[i]; }
+    bool is_alive(index_t i) const { return alive_flags[i] != 0; }
+    int move_distance(index_t i) const { return move_distances[i]; }
+    int kill_distance(index_t i) const { return kill_distances[i]; }
+    std::uint32_t id(index_t i) const { return ids[i]; }
+    const std::shared_ptr<NPC> &npc(index_t i) const { return handles[i]; }
+
+    bool is_close(index_t a, index_t b, int distance) const {
+        return within(xs[a], ys[a], xs[b], ys[b], distance);
+    }
+};
+
+#endif
\ No newline at end of file
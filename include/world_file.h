@@ -0,0 +1,65 @@
+#ifndef WORLD_FILE_H
+#define WORLD_FILE_H
+
+#include "npc.h"
+#include "mapped_file.h"
+#include "npc_arena.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <memory>
+
+constexpr char WORLD_FILE_MAGIC[4] = {'N', 'P', 'C', 'W'};
+constexpr std::uint32_t WORLD_FILE_VERSION = 2;
+
+// Layout: header, NpcRecord[count], NameEntry[names_count], string bytes.
+// Each distinct name is stored once and records refer to it by index.
+struct WorldFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t count;
+    std::uint64_t names_count;
+    std::uint64_t names_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t strings_size;
+};
+
+struct NpcRecord {
+    std::int32_t x;
+    std::int32_t y;
+    std::uint32_t type;
+    std::uint32_t name;
+};
+
+struct NameEntry {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+class WorldFile {
+private:
+    MappedFile file;
+    const char *data;
+
+    const WorldFileHeader &header() const;
+
+public:
+    explicit WorldFile(const std::string &filename);
+
+    size_t size() const;
+    const NpcRecord &record(size_t i) const;
+    size_t names_count() const;
+    std::string_view table_name(size_t n) const;
+    std::string_view name(size_t i) const;
+    std::shared_ptr<NPC> make_npc(size_t i, int limit = NPC::MAX_COORDINATE_LIMIT,
+                                  const std::shared_ptr<NpcArena> &arena = nullptr) const;
+
+    static bool is_world_file(const std::string &filename);
+};
+
+void save_binary(const set_t &array, const std::string &filename);
+// NPCs are built in one arena reserved for the whole file. Names are interned
+// into the NameTable, so they are copied out of the mapping, not aliased.
+set_t load_binary(const std::string &filename, int limit = NPC::MAX_COORDINATE_LIMIT);
+
+#endif
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "factory.h"
 #include "game.h"
+#include "batch.h"
+#include "config.h"
+#include "random.h"
 #include <iostream>
-#include <random>
+#include <string>
+#include <fstream>
 
 std::ostream &operator<<(std::ostream &os, const set_t &array) {
     for (auto &n : array) {
@@ -11,19 +15,27 @@ std::ostream &operator<<(std::ostream &os, const set_t &array) {
 }
 
 int main(int argc, char* argv[]) {
-    if (argc > 1 && std::string(argv[1]) == "lab7") {
+    bool lab7 = argc > 1 && std::string(argv[1]) == "lab7";
+
+    GameConfig config;
+    try {
+        config = parse_args(argc, argv, lab7 ? 2 : 1);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl << usage() << std::endl;
+        return 1;
+    }
+    std::uint64_t seed = config.seed;
+
+    if (lab7) {
         set_t array;
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> coord_dis(0, 500);
-        std::uniform_int_distribution<> type_dis(1, 3);
         
-        for (size_t i = 0; i < 10; ++i) {
+        for (std::uint32_t i = 0; i < 10; ++i) {
+            RandomStream rng(seed, RngPurpose::Spawn, 0, i);
             array.insert(factory(
-                static_cast<NpcType>(type_dis(gen)),
-                coord_dis(gen),
-                coord_dis(gen),
-                generate_name()
+                static_cast<NpcType>(rng.uniform(1, 3)),
+                rng.uniform(0, 500),
+                rng.uniform(0, 500),
+                generate_name(seed, i)
             ));
         }
 
@@ -40,13 +52,29 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        flush_logs();
+
         if (array.empty()) {
             std::cout << "No survivors left" << std::endl;
         } else {
             std::cout << array;
         }
+    } else if (config.batch_runs > 0) {
+        std::ofstream csv(config.csv_path);
+        if (!csv) {
+            std::cerr << "Cannot open " << config.csv_path << std::endl;
+            return 1;
+        }
+
+        set_kill_logging(false);
+        auto results = run_batch(config);
+        write_runs_csv(csv, results);
+        write_summary_csv(std::cout, summarize(results));
     } else {
-        Game game;
+        if (config.headless) {
+            set_console_logging(false);
+        }
+        Game game(config);
         game.run();
     }
     
@@ -0,0 +1,125 @@
+#include "batch.h"
+#include "game.h"
+#include "event_bus.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+static const NpcType SPECIES[] = {SquirrelType, WerewolfType, DruidType};
+
+static const char *species_name(NpcType type) {
+    switch (type) {
+        case SquirrelType: return "squirrel";
+        case WerewolfType: return "werewolf";
+        case DruidType: return "druid";
+        default: return "unknown";
+    }
+}
+
+std::uint64_t batch_ticks(const GameConfig &config) {
+    if (config.turbo_ticks > 0) return config.turbo_ticks;
+    return static_cast<std::uint64_t>(config.game_time) * 1000 / std::max(1, config.tick_ms);
+}
+
+static RunResult run_one(GameConfig config, std::uint64_t ticks) {
+    NameTable names;
+    EventBus bus;
+    Game game(config, bus, names);
+    for (std::uint64_t t = 0; t < ticks; ++t) {
+        game.step();
+    }
+
+    RunResult result;
+    result.seed = config.seed;
+    result.ticks = ticks;
+    result.fights = game.collect_metrics().fights_resolved;
+    for (NpcType type : SPECIES) {
+        result.survivors[type] = game.survivors(type);
+        result.total += result.survivors[type];
+    }
+    return result;
+}
+
+std::vector<RunResult> run_batch(const GameConfig &config) {
+    GameConfig run_config = config;
+    run_config.headless = true;
+    run_config.threads = 1;
+    run_config.turbo_ticks = 0;
+    run_config.batch_runs = 0;
+    run_config.journal_path.clear();
+    run_config.metrics_path.clear();
+
+    const std::uint64_t ticks = batch_ticks(config);
+    std::vector<RunResult> results(config.batch_runs);
+
+    ThreadPool pool(config.threads ? config.threads : std::thread::hardware_concurrency());
+    pool.run(results.size(), [&](size_t i) {
+        GameConfig game_config = run_config;
+        game_config.seed = config.seed + i;
+        results[i] = run_one(game_config, ticks);
+    });
+    return results;
+}
+
+std::vector<SpeciesStats> summarize(const std::vector<RunResult> &results) {
+    std::vector<SpeciesStats> stats;
+    if (results.empty()) return stats;
+
+    std::vector<std::uint64_t> counts(results.size());
+    for (NpcType type : SPECIES) {
+        SpeciesStats s;
+        s.type = type;
+
+        size_t extinct = 0;
+        double sum = 0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            counts[i] = results[i].survivors[type];
+            sum += static_cast<double>(counts[i]);
+            if (counts[i] == 0) ++extinct;
+        }
+        s.mean = sum / static_cast<double>(counts.size());
+
+        double squares = 0;
+        for (auto c : counts) {
+            double d = static_cast<double>(c) - s.mean;
+            squares += d * d;
+        }
+        s.stddev = std::sqrt(squares / static_cast<double>(counts.size()));
+        s.extinct = static_cast<double>(extinct) / static_cast<double>(counts.size());
+
+        std::sort(counts.begin(), counts.end());
+        auto rank = [&counts](double q) {
+            return counts[static_cast<size_t>(q * static_cast<double>(counts.size() - 1))];
+        };
+        s.min = counts.front();
+        s.p10 = rank(0.10);
+        s.p50 = rank(0.50);
+        s.p90 = rank(0.90);
+        s.max = counts.back();
+
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+void write_runs_csv(std::ostream &os, const std::vector<RunResult> &results) {
+    os << "run,seed,ticks,fights,squirrel,werewolf,druid,total\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto &r = results[i];
+        os << i << ',' << r.seed << ',' << r.ticks << ',' << r.fights
+           << ',' << r.survivors[SquirrelType]
+           << ',' << r.survivors[WerewolfType]
+           << ',' << r.survivors[DruidType]
+           << ',' << r.total << '\n';
+    }
+}
+
+void write_summary_csv(std::ostream &os, const std::vector<SpeciesStats> &stats) {
+    os << "species,mean,stddev,min,p10,p50,p90,max,extinct_rate\n";
+    for (const auto &s : stats) {
+        os << species_name(s.type) << ',' << s.mean << ',' << s.stddev
+           << ',' << s.min << ',' << s.p10 << ',' << s.p50 << ',' << s.p90
+           << ',' << s.max << ',' << s.extinct << '\n';
+    }
+}
@@ -0,0 +1,124 @@
+#include "config.h"
+#include <stdexcept>
+#include <climits>
+
+static long long parse_number(const std::string &flag, const std::string &value, long long min,
+                              long long max = LLONG_MAX) {
+    size_t used = 0;
+    long long result = 0;
+    try {
+        result = std::stoll(value, &used);
+    } catch (const std::exception &) {
+        used = 0;
+    }
+
+    if (used != value.size() || result < min || result > max) {
+        throw std::invalid_argument("Invalid value for " + flag + ": " + value);
+    }
+    return result;
+}
+
+static std::uint64_t parse_seed(const std::string &value) {
+    size_t used = 0;
+    unsigned long long result = 0;
+    if (!value.empty() && value[0] >= '0' && value[0] <= '9') {
+        try {
+            result = std::stoull(value, &used);
+        } catch (const std::exception &) {
+            used = 0;
+        }
+    }
+
+    if (used == 0 || used != value.size()) {
+        throw std::invalid_argument("Invalid value for --seed: " + value);
+    }
+    return static_cast<std::uint64_t>(result);
+}
+
+static QueuePolicy parse_policy(const std::string &value) {
+    if (value == "block") return QueuePolicy::Block;
+    if (value == "drop-oldest") return QueuePolicy::DropOldest;
+    if (value == "drop-newest") return QueuePolicy::DropNewest;
+    throw std::invalid_argument("Unknown queue policy: " + value);
+}
+
+static Viewport parse_viewport(const std::string &value, Viewport view) {
+    long long parts[4];
+    size_t start = 0;
+    for (int i = 0; i < 4; ++i) {
+        size_t end = value.find(',', start);
+        if ((end == std::string::npos) != (i == 3)) {
+            throw std::invalid_argument("Invalid value for --viewport: " + value);
+        }
+        parts[i] = parse_number("--viewport", value.substr(start, end - start), i < 2 ? 0 : 1, INT_MAX);
+        start = end + 1;
+    }
+
+    view.x = static_cast<int>(parts[0]);
+    view.y = static_cast<int>(parts[1]);
+    view.cols = static_cast<int>(parts[2]);
+    view.rows = static_cast<int>(parts[3]);
+    return view;
+}
+
+GameConfig parse_args(int argc, char *argv[], int first) {
+    GameConfig config;
+
+    for (int i = first; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--headless") {
+            config.headless = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Unknown option or missing value: " + arg);
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--map-size") {
+            config.map_size = static_cast<int>(parse_number(arg, value, 1, INT_MAX));
+        } else if (arg == "--npcs") {
+            config.npc_count = static_cast<int>(parse_number(arg, value, 0, INT_MAX));
+        } else if (arg == "--time") {
+            config.game_time = static_cast<int>(parse_number(arg, value, 0, INT_MAX));
+        } else if (arg == "--tick-ms") {
+            config.tick_ms = static_cast<int>(parse_number(arg, value, 1, INT_MAX));
+        } else if (arg == "--turbo") {
+            config.turbo_ticks = static_cast<std::uint64_t>(parse_number(arg, value, 1));
+        } else if (arg == "--threads") {
+            config.threads = static_cast<unsigned>(parse_number(arg, value, 1, INT_MAX));
+        } else if (arg == "--seed") {
+            config.seed = parse_seed(value);
+        } else if (arg == "--queue-capacity") {
+            config.queue_capacity = static_cast<size_t>(parse_number(arg, value, 1));
+        } else if (arg == "--queue-policy") {
+            config.queue_policy = parse_policy(value);
+        } else if (arg == "--journal") {
+            config.journal_path = value;
+        } else if (arg == "--metrics") {
+            config.metrics_path = value;
+        } else if (arg == "--batch") {
+            config.batch_runs = static_cast<std::uint64_t>(parse_number(arg, value, 1));
+        } else if (arg == "--csv") {
+            config.csv_path = value;
+        } else if (arg == "--zoom") {
+            config.viewport.zoom = static_cast<int>(parse_number(arg, value, 1, INT_MAX));
+        } else if (arg == "--viewport") {
+            config.viewport = parse_viewport(value, config.viewport);
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+
+    return config;
+}
+
+std::string usage() {
+    return "Usage: lab07 [lab7] [--map-size N] [--npcs N] [--time SECONDS] [--tick-ms MS] [--turbo TICKS]\n"
+           "             [--seed N] [--headless] [--threads N] [--queue-capacity N]\n"
+           "             [--queue-policy block|drop-oldest|drop-newest] [--journal PATH]\n"
+           "             [--zoom UNITS_PER_CELL] [--viewport X,Y,COLS,ROWS]\n"
+           "             [--metrics PATH(.prom|.json)] [--batch RUNS] [--csv PATH]";
+}
\ No newline at end of file
@@ -2,17 +2,17 @@
 #include "squirrel.h"
 #include "werewolf.h"
 
-Druid::Druid(int x, int y, const std::string& name) 
-    : NPC(DruidType, x, y, name) {}
+Druid::Druid(int x, int y, std::string_view name, int limit, NameTable &names)
+    : NPC(DruidType, x, y, name, limit, names) {}
 
-Druid::Druid(std::istream &is) : NPC(DruidType, is) {}
+Druid::Druid(std::istream &is, int limit) : NPC(DruidType, is, limit) {}
 
 void Druid::print() {
     std::cout << *this;
 }
 
 void Druid::save(std::ostream &os) {
-    os << DruidType << std::endl;
+    os << DruidType << '\n';
     NPC::save(os);
 }
 
@@ -20,21 +20,6 @@ bool Druid::accept(std::shared_ptr<NPCVisitor> visitor) {
     return visitor->visit(std::static_pointer_cast<Druid>(shared_from_this()));
 }
 
-bool Druid::fight(std::shared_ptr<Squirrel> other) {
-    fight_notify(other, false);
-    return false;
-}
-
-bool Druid::fight(std::shared_ptr<Werewolf> other) {
-    fight_notify(other, false);
-    return false;
-}
-
-bool Druid::fight(std::shared_ptr<Druid> other) {
-    fight_notify(other, false);
-    return false;
-}
-
 int Druid::get_move_distance() const {
     return 10;
 }
@@ -0,0 +1,59 @@
+#include "event_bus.h"
+#include <algorithm>
+#include <mutex>
+
+EventBus &EventBus::global() {
+    static EventBus bus;
+    return bus;
+}
+
+EventBus::subscription_t EventBus::subscribe(EventKind kind, std::shared_ptr<IFightObserver> observer) {
+    std::unique_lock lock(mutex);
+    subscription_t id = next_id++;
+    subscriptions.push_back({id, kind, std::move(observer)});
+    (kind == EventKind::Fight ? fight_subscribers : kill_subscribers)++;
+    return id;
+}
+
+void EventBus::unsubscribe(subscription_t id) {
+    std::unique_lock lock(mutex);
+    auto it = std::find_if(subscriptions.begin(), subscriptions.end(),
+        [id](const Subscription &s) { return s.id == id; });
+    if (it == subscriptions.end()) return;
+
+    (it->kind == EventKind::Fight ? fight_subscribers : kill_subscribers)--;
+    subscriptions.erase(it);
+}
+
+bool EventBus::wants(EventKind kind) const {
+    if (fight_subscribers.load(std::memory_order_relaxed) > 0) return true;
+    return kind == EventKind::Kill && kill_subscribers.load(std::memory_order_relaxed) > 0;
+}
+
+void EventBus::publish(const FightNotice *notices, size_t count) {
+    if (count == 0) return;
+
+    std::shared_lock lock(mutex);
+    std::vector<FightNotice> kills;
+    bool filtered = false;
+
+    for (const auto &s : subscriptions) {
+        if (s.kind == EventKind::Fight) {
+            s.observer->on_fights(notices, count);
+            continue;
+        }
+
+        if (!filtered) {
+            std::copy_if(notices, notices + count, std::back_inserter(kills),
+                [](const FightNotice &n) { return n.win; });
+            filtered = true;
+        }
+        if (!kills.empty()) {
+            s.observer->on_fights(kills.data(), kills.size());
+        }
+    }
+}
+
+void EventBus::publish(const FightNotice &notice) {
+    publish(&notice, 1);
+}
\ No newline at end of file
@@ -3,10 +3,22 @@
 #include "werewolf.h"
 #include "druid.h"
 #include "visitor.h"
+#include "combat.h"
+#include "random.h"
+#include "world_file.h"
+#include "npc_stream.h"
+#include "log_sink.h"
+#include "event_bus.h"
+#include "range_query.h"
 #include <fstream>
-#include <cstring>
-#include <random>
+#include <atomic>
+#include <mutex>
 #include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <climits>
+#include <iterator>
 
 std::string NpcTypeToString(NpcType type) {
     switch (type) {
@@ -17,24 +29,63 @@ std::string NpcTypeToString(NpcType type) {
     }
 }
 
+static void append_text_npc(std::string &out, NpcType type, std::string_view name, int x, int y) {
+    out += NpcTypeToString(type);
+    out += ": {name: \"";
+    out += name;
+    out += "\", x:";
+    out += std::to_string(x);
+    out += ", y:";
+    out += std::to_string(y);
+    out += "}\n";
+}
+
+static void append_file_npc(std::string &out, NpcType type, std::string_view name, int x, int y) {
+    out += NpcTypeToString(type);
+    out += " \"";
+    out += name;
+    out += "\" {x:";
+    out += std::to_string(x);
+    out += ", y:";
+    out += std::to_string(y);
+    out += "}\n";
+}
+
+static void format_text(std::string &out, const KillRecord &r) {
+    out += "\nMurder --------\nKiller: ";
+    append_text_npc(out, r.attacker_type, r.attacker_name, r.attacker_x, r.attacker_y);
+    out += "Victim: ";
+    append_text_npc(out, r.defender_type, r.defender_name, r.defender_x, r.defender_y);
+}
+
+static void format_file(std::string &out, const KillRecord &r) {
+    out += "\nMurder ---\nKiller: ";
+    append_file_npc(out, r.attacker_type, r.attacker_name, r.attacker_x, r.attacker_y);
+    out += "Victim: ";
+    append_file_npc(out, r.defender_type, r.defender_name, r.defender_x, r.defender_y);
+}
+
 class TextObserver : public IFightObserver {
 private:
-    TextObserver(){};
+    LogSink sink;
+    TextObserver() : sink(std::cout, format_text) {}
 public:
+    static TextObserver &instance() {
+        static TextObserver observer;
+        return observer;
+    }
+
     static std::shared_ptr<IFightObserver> get() {
-        static TextObserver instance;
-        return std::shared_ptr<IFightObserver>(&instance, [](IFightObserver *) {});
-    }
-
-    void on_fight(const std::shared_ptr<NPC> attacker, 
-                 const std::shared_ptr<NPC> defender, 
-                 bool win) override {
-        if (win) {
-            std::cout << std::endl << "Murder --------" << std::endl;
-            std::cout << "Killer: ";
-            attacker->print();
-            std::cout << "Victim: ";
-            defender->print();
+        return std::shared_ptr<IFightObserver>(&instance(), [](IFightObserver *) {});
+    }
+
+    void flush() {
+        sink.flush();
+    }
+
+    void on_fights(const FightNotice *notices, size_t count) override {
+        for (size_t i = 0; i < count; ++i) {
+            sink.post(make_kill_record(*notices[i].attacker, *notices[i].defender));
         }
     }
 };
@@ -42,33 +93,109 @@ public:
 class FileObserver : public IFightObserver {
 private:
     std::ofstream file;
-    FileObserver() {
-        file.open("log.txt", std::ios::app);
-    }
+    LogSink sink;
+    FileObserver() : file("log.txt", std::ios::app), sink(file, format_file) {}
 public:
+    static FileObserver &instance() {
+        static FileObserver observer;
+        return observer;
+    }
+
     static std::shared_ptr<IFightObserver> get() {
-        static FileObserver instance;
-        return std::shared_ptr<IFightObserver>(&instance, [](IFightObserver *) {});
-    }
-
-    void on_fight(const std::shared_ptr<NPC> attacker, 
-                 const std::shared_ptr<NPC> defender, 
-                 bool win) override {
-        if (win) {
-            file << std::endl << "Murder ---" << std::endl;
-            file << "Killer: ";
-            file << NpcTypeToString(attacker->get_type());
-            file << " \"" << attacker->get_name() << "\" {x:" 
-                 << attacker->get_x() << ", y:" << attacker->get_y() << "}" << std::endl;
-            file << "Victim: ";
-            file << NpcTypeToString(defender->get_type());
-            file << " \"" << defender->get_name() << "\" {x:" 
-                 << defender->get_x() << ", y:" << defender->get_y() << "}" << std::endl;
+        return std::shared_ptr<IFightObserver>(&instance(), [](IFightObserver *) {});
+    }
+
+    void flush() {
+        sink.flush();
+    }
+
+    void on_fights(const FightNotice *notices, size_t count) override {
+        for (size_t i = 0; i < count; ++i) {
+            sink.post(make_kill_record(*notices[i].attacker, *notices[i].defender));
         }
     }
 };
 
-std::shared_ptr<NPC> factory(std::istream &is) {
+enum LogTarget {
+    ConsoleLog,
+    FileLog,
+    LOG_TARGET_COUNT
+};
+
+static std::mutex logging_mutex;
+static std::atomic<bool> logging_settled{false};
+static bool logging_enabled[LOG_TARGET_COUNT] = {true, true};
+static EventBus::subscription_t log_subscriptions[LOG_TARGET_COUNT] = {};
+
+static std::shared_ptr<IFightObserver> log_observer(LogTarget target) {
+    return target == ConsoleLog ? TextObserver::get() : FileObserver::get();
+}
+
+static void subscribe_observers() {
+    if (logging_settled.load(std::memory_order_acquire)) return;
+
+    std::lock_guard lock(logging_mutex);
+    for (int t = 0; t < LOG_TARGET_COUNT; ++t) {
+        if (logging_enabled[t] && log_subscriptions[t] == 0) {
+            log_subscriptions[t] = EventBus::global().subscribe(EventKind::Kill,
+                                                                log_observer(static_cast<LogTarget>(t)));
+        }
+    }
+    logging_settled.store(true, std::memory_order_release);
+}
+
+static void set_logging(LogTarget first, LogTarget last, bool enabled) {
+    {
+        std::lock_guard lock(logging_mutex);
+        for (int t = first; t <= last; ++t) {
+            logging_enabled[t] = enabled;
+            if (enabled || log_subscriptions[t] == 0) continue;
+
+            EventBus::global().unsubscribe(log_subscriptions[t]);
+            log_subscriptions[t] = 0;
+        }
+        // Re-enabled targets subscribe lazily with the next NPC.
+        if (enabled) logging_settled.store(false, std::memory_order_release);
+    }
+    if (!enabled) flush_logs();
+}
+
+void set_kill_logging(bool enabled) {
+    set_logging(ConsoleLog, FileLog, enabled);
+}
+
+void set_console_logging(bool enabled) {
+    set_logging(ConsoleLog, ConsoleLog, enabled);
+}
+
+void flush_logs() {
+    TextObserver::instance().flush();
+    FileObserver::instance().flush();
+}
+
+template <typename T, typename... Args>
+static std::shared_ptr<NPC> make_npc(const std::shared_ptr<NpcArena> &arena, Args &&...args) {
+    if (arena) {
+        return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+template <typename T>
+static size_t probe_footprint() {
+    // A private table keeps the probe's empty name out of the global one.
+    NameTable names;
+    return arena_footprint<T>(0, 0, std::string_view(), 0, names);
+}
+
+size_t npc_arena_bytes(size_t count) {
+    constexpr size_t align = alignof(std::max_align_t);
+    static const size_t largest = std::max({probe_footprint<Squirrel>(), probe_footprint<Werewolf>(),
+                                            probe_footprint<Druid>()});
+    return count * ((largest + align - 1) / align * align);
+}
+
+std::shared_ptr<NPC> factory(std::istream &is, int limit, const std::shared_ptr<NpcArena> &arena) {
     std::shared_ptr<NPC> result;
     int type{0};
     
@@ -76,13 +203,13 @@ std::shared_ptr<NPC> factory(std::istream &is) {
         try {
             switch (type) {
                 case SquirrelType:
-                    result = std::make_shared<Squirrel>(is);
+                    result = make_npc<Squirrel>(arena, is, limit);
                     break;
                 case WerewolfType:
-                    result = std::make_shared<Werewolf>(is);
+                    result = make_npc<Werewolf>(arena, is, limit);
                     break;
                 case DruidType:
-                    result = std::make_shared<Druid>(is);
+                    result = make_npc<Druid>(arena, is, limit);
                     break;
                 default:
                     std::cerr << "Unexpected NPC type: " << type << std::endl;
@@ -93,25 +220,25 @@ std::shared_ptr<NPC> factory(std::istream &is) {
     }
 
     if (result) {
-        result->subscribe(TextObserver::get());
-        result->subscribe(FileObserver::get());
+        subscribe_observers();
     }
 
     return result;
 }
 
-std::shared_ptr<NPC> factory(NpcType type, int x, int y, const std::string& name) {
+std::shared_ptr<NPC> factory(NpcType type, int x, int y, std::string_view name, int limit,
+                             const std::shared_ptr<NpcArena> &arena, NameTable &names) {
     std::shared_ptr<NPC> result;
     try {
         switch (type) {
             case SquirrelType:
-                result = std::make_shared<Squirrel>(x, y, name);
+                result = make_npc<Squirrel>(arena, x, y, name, limit, names);
                 break;
             case WerewolfType:
-                result = std::make_shared<Werewolf>(x, y, name);
+                result = make_npc<Werewolf>(arena, x, y, name, limit, names);
                 break;
             case DruidType:
-                result = std::make_shared<Druid>(x, y, name);
+                result = make_npc<Druid>(arena, x, y, name, limit, names);
                 break;
             default:
                 std::cerr << "Unknown NPC type: " << type << std::endl;
@@ -121,8 +248,7 @@ std::shared_ptr<NPC> factory(NpcType type, int x, int y, const std::string& name
     }
     
     if (result) {
-        result->subscribe(TextObserver::get());
-        result->subscribe(FileObserver::get());
+        subscribe_observers();
     }
 
     return result;
@@ -130,7 +256,7 @@ std::shared_ptr<NPC> factory(NpcType type, int x, int y, const std::string& name
 
 void save(const set_t &array, const std::string &filename) {
     std::ofstream fs(filename);
-    fs << array.size() << std::endl;
+    fs << array.size() << '\n';
     for (auto &n : array) {
         n->save(fs);
     }
@@ -138,52 +264,107 @@ void save(const set_t &array, const std::string &filename) {
     fs.close();
 }
 
-set_t load(const std::string &filename) {
+set_t load(const std::string &filename, int limit) {
+    if (WorldFile::is_world_file(filename)) {
+        return load_binary(filename, limit);
+    }
+
     set_t result;
-    std::ifstream is(filename);
-    
-    if (is.good() && is.is_open()) {
-        int count;
-        is >> count;
-        for (int i = 0; i < count; ++i) {
-            result.insert(factory(is));
+    try {
+        auto stats = stream_npcs(filename, [&result, limit](const NpcEntry &entry) {
+            auto npc = factory(entry.type, entry.x, entry.y, entry.name, limit);
+            if (npc) {
+                result.insert(npc);
+            }
+        });
+
+        if (stats.errors > 0) {
+            std::cerr << "Skipped " << stats.errors << " malformed NPC records" << std::endl;
         }
-        is.close();
-    } else {
-        std::cerr << "Error: " << std::strerror(errno) << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
     }
     return result;
 }
 
 set_t fight(const set_t &array, size_t distance) {
-    set_t dead_list;
+    std::vector<std::shared_ptr<NPC>> sorted;
+    sorted.reserve(array.size());
+    for (const auto &npc : array) {
+        if (npc) sorted.push_back(npc);
+    }
+
+    std::sort(sorted.begin(), sorted.end(),
+        [](const std::shared_ptr<NPC> &a, const std::shared_ptr<NPC> &b) {
+            return a->get_x() < b->get_x();
+        });
+
+    std::vector<int> xs(sorted.size());
+    std::vector<int> ys(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        xs[i] = sorted[i]->get_x();
+        ys[i] = sorted[i]->get_y();
+    }
 
-    for (const auto &attacker : array) {
-        for (const auto &defender : array) {
-            if ((attacker != defender) && 
-                (attacker->is_close(defender, distance)) &&
-                !dead_list.count(defender)) {
-            
-                auto visitor = std::make_shared<FightVisitor>(attacker);
-                bool success = defender->accept(visitor);
-                
-                if (success) {
-                    dead_list.insert(defender);
-                }
+    std::vector<bool> dead(sorted.size(), false);
+    std::vector<FightNotice> kills;
+    std::vector<std::uint32_t> hits(sorted.size());
+    long long reach = static_cast<long long>(distance);
+    int radius = static_cast<int>(std::min<size_t>(distance, INT_MAX));
+
+    size_t end = 0;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const auto &left = sorted[i];
+        end = std::max(end, i + 1);
+        while (end < sorted.size() && static_cast<long long>(xs[end]) - xs[i] <= reach) ++end;
+
+        size_t n = select_close(xs.data() + i + 1, ys.data() + i + 1, end - i - 1,
+                                xs[i], ys[i], radius, hits.data());
+        for (size_t k = 0; k < n; ++k) {
+            size_t j = i + 1 + hits[k];
+            const auto &right = sorted[j];
+
+            if (!dead[j] && can_kill(left->get_type(), right->get_type())) {
+                kills.push_back({left.get(), right.get(), true});
+                dead[j] = true;
+            }
+            if (!dead[i] && can_kill(right->get_type(), left->get_type())) {
+                kills.push_back({right.get(), left.get(), true});
+                dead[i] = true;
             }
         }
     }
 
+    EventBus::global().publish(kills.data(), kills.size());
+
+    set_t dead_list;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (dead[i]) dead_list.insert(sorted[i]);
+    }
+
     return dead_list;
 }
 
-std::string generate_name() {
-    static std::vector<std::string> names = {
+std::string_view generate_name(std::uint64_t seed, std::uint32_t id, NameTable &table) {
+    static const std::string_view names[] = {
         "Swift", "Brave", "Smart", "Agile", "Red", "Forest", 
         "Night", "Gray", "Strong", "Wise", "Old", "Quiet"
     };
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, names.size() - 1);
-    return names[dis(gen)] + "_" + std::to_string(rd() % 1000);
+    const int count = static_cast<int>(std::size(names));
+
+    RandomStream rng(seed, RngPurpose::Name, 0, id);
+    std::string_view first = names[rng.uniform(0, count - 1)];
+
+    char buffer[32];
+    std::memcpy(buffer, first.data(), first.size());
+    buffer[first.size()] = '_';
+    char *end = std::to_chars(buffer + first.size() + 1, buffer + sizeof(buffer), rng.uniform(0, 999)).ptr;
+
+    return table.get(table.intern(std::string_view(buffer, end - buffer)));
+}
+
+std::string_view generate_name() {
+    static const std::uint64_t seed = random_seed();
+    static std::atomic<std::uint32_t> next_id{0};
+    return generate_name(seed, next_id++);
 }
\ No newline at end of file
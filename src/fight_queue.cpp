@@ -0,0 +1,63 @@
+#include "fight_queue.h"
+#include <thread>
+
+FightQueue::FightQueue(size_t capacity, QueuePolicy policy)
+    : ring(capacity), policy(policy) {}
+
+size_t FightQueue::publish(const std::vector<Fight> &fights, const std::atomic<bool> &running) {
+    size_t published = 0;
+    size_t evicted_count = 0;
+    while (published < fights.size() && running) {
+        size_t pushed = ring.push_batch(fights.data() + published, fights.size() - published);
+        published += pushed;
+
+        if (published == fights.size()) break;
+
+        switch (policy) {
+            case QueuePolicy::Block:
+                if (pushed == 0) std::this_thread::yield();
+                break;
+            case QueuePolicy::DropOldest: {
+                evicted.resize(fights.size() - published);
+                size_t popped = ring.pop_batch(evicted.data(), evicted.size());
+                evicted_count += popped;
+                dropped.fetch_add(popped, std::memory_order_relaxed);
+                break;
+            }
+            case QueuePolicy::DropNewest:
+                dropped.fetch_add(fights.size() - published, std::memory_order_relaxed);
+                enqueued.fetch_add(published, std::memory_order_relaxed);
+                return published;
+        }
+    }
+
+    enqueued.fetch_add(published, std::memory_order_relaxed);
+    return published - evicted_count;
+}
+
+size_t FightQueue::drain(Fight *out, size_t max_count) {
+    return ring.pop_batch(out, max_count);
+}
+
+bool FightQueue::empty() const {
+    return ring.empty();
+}
+
+size_t FightQueue::size() const {
+    return ring.size();
+}
+
+size_t FightQueue::capacity() const {
+    return ring.capacity();
+}
+
+QueuePolicy FightQueue::get_policy() const {
+    return policy;
+}
+
+FightQueueStats FightQueue::stats() const {
+    return {
+        enqueued.load(std::memory_order_relaxed),
+        dropped.load(std::memory_order_relaxed)
+    };
+}
\ No newline at end of file
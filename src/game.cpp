@@ -3,248 +3,604 @@
 #include "druid.h"
 #include "squirrel.h"
 #include "werewolf.h"
-#include "visitor.h"
+#include "combat.h"
 #include <iostream>
-#include <random>
 #include <chrono>
 #include <algorithm>
 
 using namespace std::chrono_literals;
 
-Game::Game() : running(true) {
+template <typename Lock, typename Mutex>
+static Lock timed_lock(Mutex &mutex, ThreadMetrics &metrics, LockId id) {
+    auto start = metrics_clock::now();
+    Lock lock(mutex);
+    metrics.record_wait(id, elapsed_ns(start));
+    return lock;
+}
+
+Game::Game(const GameConfig &config, EventBus &bus, NameTable &names)
+    : config(config), seed(config.seed), bus(bus), names(names), spatial_grid(config.map_size, config.map_size),
+      running(true), fight_queue(config.queue_capacity, config.queue_policy),
+      pool(config.threads ? config.threads : std::thread::hardware_concurrency())
+{
     create_npcs();
+    create_regions();
+    publish_snapshot();
+
+    if (!config.headless) {
+        Viewport view = config.viewport;
+        int fit_cols = std::max(1, (config.map_size - view.x) / view.zoom);
+        int fit_rows = std::max(1, (config.map_size - view.y) / view.zoom);
+        if (view.cols == 0) view.cols = std::min(fit_cols, static_cast<int>(MAX_VIEW_COLS));
+        if (view.rows == 0) view.rows = std::min(fit_rows, static_cast<int>(MAX_VIEW_ROWS));
+        renderer = std::make_unique<MapRenderer>(view);
+    }
+
+    if (!config.journal_path.empty()) {
+        journal = std::make_unique<JournalWriter>(config.journal_path);
+    }
+    if (!config.metrics_path.empty()) {
+        exporter = std::make_unique<MetricsExporter>(config.metrics_path);
+    }
 }
 
 Game::~Game() {
-    running = false;
-    queue_cv.notify_all();
+    stop();
     
     if (move_thread.joinable()) move_thread.join();
     if (fight_thread.joinable()) fight_thread.join();
 }
 
 void Game::create_npcs() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> pos_dist(0, MAP_SIZE - 1);
-    std::uniform_int_distribution<> type_dist(0, 2);
-    
-    std::unique_lock lock(npcs_mutex);
-    for (int i = 0; i < NPC_COUNT; ++i) {
-        int x = pos_dist(gen);
-        int y = pos_dist(gen);
-        NpcType type = static_cast<NpcType>(type_dist(gen));
+    const int limit = config.map_size - 1;
+
+    // One contiguous arena for the whole population; the shared_ptr control
+    // blocks are carved out of it too, so teardown is a single release.
+    arena = std::make_shared<NpcArena>(npc_arena_bytes(static_cast<size_t>(config.npc_count)));
+
+    world.reserve(config.npc_count);
+    for (int i = 0; i < config.npc_count; ++i) {
+        RandomStream rng(seed, RngPurpose::Spawn, 0, i);
+        int x = rng.uniform(0, limit);
+        int y = rng.uniform(0, limit);
+        NpcType type = static_cast<NpcType>(rng.uniform(SquirrelType, DruidType));
         
-        auto name = generate_name();
-        auto npc = factory(type, x, y, name);
+        auto name = generate_name(seed, i, names);
+        auto npc = factory(type, x, y, name, limit, arena, names);
         if (npc) {
-            npcs.insert(npc);
+            world.add(npc);
         }
     }
+
+    // Tiles at least as wide as the longest reach keep every query within a
+    // 3x3 block; small maps still get enough columns to shard into regions.
+    int cell = std::max(1, std::min(static_cast<int>(TILE_SIZE), config.map_size / MAX_REGIONS));
+    for (World::index_t i = 0; i < world.size(); ++i) {
+        cell = std::max(cell, world.kill_distance(i));
+    }
+
+    spatial_grid = SpatialGrid(config.map_size, cell);
+    for (World::index_t i = 0; i < world.size(); ++i) {
+        bool active = world.move_distance(i) > 0 || world.kill_distance(i) > 0;
+        spatial_grid.insert(i, world.x(i), world.y(i), active);
+    }
+}
+
+void Game::create_regions() {
+    int cols = spatial_grid.get_cols();
+    int count = std::max(1, std::min(cols, static_cast<int>(MAX_REGIONS)));
+
+    regions.resize(count);
+    for (int r = 0; r < count; ++r) {
+        regions[r].first_col = r * cols / count;
+        regions[r].last_col = (r + 1) * cols / count;
+    }
+}
+
+void Game::assign_tiles() {
+    for (auto &region : regions) {
+        region.tiles.clear();
+    }
+
+    int cols = spatial_grid.get_cols();
+    for (SpatialGrid::tile_id t : spatial_grid.awake_tiles()) {
+        int col = spatial_grid.tile(t).tx;
+        size_t r = static_cast<size_t>(static_cast<long long>(col) * static_cast<long long>(regions.size()) / cols);
+        while (r + 1 < regions.size() && col >= regions[r + 1].first_col) ++r;
+        while (r > 0 && col < regions[r].first_col) --r;
+        regions[r].tiles.push_back(t);
+    }
+}
+
+bool Game::owns(const Region &region, World::index_t index) const {
+    int col = spatial_grid.column_of(world.x(index));
+    return col >= region.first_col && col < region.last_col;
 }
 
-void Game::move_npc(std::shared_ptr<NPC> npc) {
-    if (!npc->is_alive()) return;
+void Game::move_npc(Region &region, World::index_t index) {
+    if (!world.is_alive(index)) return;
     
-    int dist = npc->get_move_distance();
+    int dist = world.move_distance(index);
     if (dist == 0) return;
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dir_dist(-1, 1);
-    
-    int dx = dir_dist(gen);
-    int dy = dir_dist(gen);
+    RandomStream rng(seed, RngPurpose::Move, tick, world.id(index));
     
-    int new_x = npc->get_x() + dx * dist;
-    int new_y = npc->get_y() + dy * dist;
+    int dx = rng.uniform(-1, 1);
+    int dy = rng.uniform(-1, 1);
     
-    new_x = std::max(0, std::min(MAP_SIZE - 1, new_x));
-    new_y = std::max(0, std::min(MAP_SIZE - 1, new_y));
+    int old_x = world.x(index);
+    int old_y = world.y(index);
+
+    // Near INT_MAX the step itself overflows an int, so clamp in 64 bits.
+    long long limit = static_cast<long long>(config.map_size) - 1;
+    int new_x = static_cast<int>(std::clamp(static_cast<long long>(old_x) + dx * dist, 0LL, limit));
+    int new_y = static_cast<int>(std::clamp(static_cast<long long>(old_y) + dy * dist, 0LL, limit));
     
-    npc->set_position(new_x, new_y);
+    if (new_x == old_x && new_y == old_y) return;
+
+    world.set_position(index, new_x, new_y);
+    region.migrations.push_back(index);
 }
 
-bool Game::process_fight(std::shared_ptr<NPC> attacker, std::shared_ptr<NPC> defender) {
-    if (!attacker->is_alive() || !defender->is_alive()) {
+bool Game::process_fight(const Fight &fight, TickLog &log) {
+    World::index_t attacker_index = fight.attacker;
+    World::index_t defender_index = fight.defender;
+
+    if (!world.is_alive(attacker_index) || !world.is_alive(defender_index)) {
         return false;
     }
+    log.resolved++;
+
+    const auto &attacker = world.npc(attacker_index);
+    const auto &defender = world.npc(defender_index);
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dice(1, 6);
+    RandomStream rng(seed, RngPurpose::Fight, fight.tick,
+                     world.id(attacker_index), world.id(defender_index));
     
-    int attack = dice(gen);
-    int defense = dice(gen);
+    int attack = rng.uniform(1, 6);
+    int defense = rng.uniform(1, 6);
     
-    auto visitor = std::make_shared<FightVisitor>(attacker);
-    bool can_kill = defender->accept(visitor);
+    bool lethal = can_kill(world.type(attacker_index), world.type(defender_index));
+    bool killed = lethal && attack > defense;
+
+    if (journal) {
+        FightEvent event{};
+        event.tick = fight.tick;
+        event.attacker_id = world.id(attacker_index);
+        event.defender_id = world.id(defender_index);
+        event.attacker_type = static_cast<std::uint8_t>(world.type(attacker_index));
+        event.defender_type = static_cast<std::uint8_t>(world.type(defender_index));
+        event.attack_roll = static_cast<std::uint8_t>(attack);
+        event.defense_roll = static_cast<std::uint8_t>(defense);
+        event.attacker_x = world.x(attacker_index);
+        event.attacker_y = world.y(attacker_index);
+        event.defender_x = world.x(defender_index);
+        event.defender_y = world.y(defender_index);
+        event.outcome = killed ? FightOutcome::Killed
+                      : lethal ? FightOutcome::Missed : FightOutcome::Immune;
+        log.events.push_back(event);
+    }
     
-    if (can_kill && attack > defense) {
-        defender->make_dead();
-        attacker->fight_notify(defender, true);
+    if (notify_fights || (killed && notify_kills)) {
+        log.notices.push_back({attacker.get(), defender.get(), killed});
+    }
+
+    if (killed) {
+        world.kill(defender_index);
+        log.killed.push_back(defender_index);
+        log.kills[world.type(attacker_index)]++;
         
-        {
+        if (!config.headless) {
+            auto start = metrics_clock::now();
             std::lock_guard lock(cout_mutex);
+            log.cout_waits++;
+            log.cout_wait_ns += elapsed_ns(start);
             std::cout << attacker->get_name() << " killed " << defender->get_name() << std::endl;
         }
         
         return true;
-    } else {
-        attacker->fight_notify(defender, false);
-        return false;
     }
+    return false;
 }
 
-void Game::move_worker() {
-    while (running) {
-        {
-            std::shared_lock lock(npcs_mutex);
-            
-            for (auto& npc : npcs) {
-                if (!npc->is_alive()) continue;
-                
-                move_npc(npc);
-                
-                int kill_dist = npc->get_kill_distance();
-                if (kill_dist > 0) {
-                    for (auto& other : npcs) {
-                        if (npc == other || !other->is_alive()) continue;
-                        
-                        if (npc->is_close(other, kill_dist)) {
-                            std::lock_guard qlock(queue_mutex);
-                            fight_queue.push({npc, other});
-                            queue_cv.notify_one();
-                        }
+void Game::move_region(Region &region) {
+    region.migrations.clear();
+    for (SpatialGrid::tile_id t : region.tiles) {
+        for (World::index_t i : spatial_grid.tile(t).members) {
+            move_npc(region, i);
+        }
+    }
+}
+
+void Game::fight_region(Region &region) {
+    region.handoff.clear();
+    region.fights = 0;
+    region.log.events.clear();
+    region.log.notices.clear();
+    region.log.killed.clear();
+    for (SpatialGrid::tile_id t : region.tiles) {
+        for (World::index_t i : spatial_grid.tile(t).members) {
+            int kill_dist = world.kill_distance(i);
+            if (kill_dist <= 0 || !world.is_alive(i)) continue;
+
+            spatial_grid.for_each_close(world.x(i), world.y(i), kill_dist, region.hits,
+                [&](World::index_t other) {
+                    if (i == other) return;
+
+                    if (owns(region, other)) {
+                        region.fights++;
+                        process_fight({i, other, tick}, region.log);
+                    } else {
+                        region.handoff.push_back({i, other, tick});
                     }
-                }
-            }
+                });
         }
-        
-        std::this_thread::sleep_for(50ms);
     }
 }
 
-void Game::fight_worker() {
-    while (running) {
-        Fight fight;
-        bool has_fight = false;
-        
-        {
-            std::unique_lock lock(queue_mutex);
-            queue_cv.wait_for(lock, 100ms, [this]() {
-                return !fight_queue.empty() || !running;
-            });
-            
-            if (!fight_queue.empty()) {
-                fight = fight_queue.front();
-                fight_queue.pop();
-                has_fight = true;
-            }
+size_t Game::run_tick(bool inline_fights) {
+    auto started = metrics_clock::now();
+    notify_fights = bus.wants(EventKind::Fight);
+    notify_kills = bus.wants(EventKind::Kill);
+    
+    assign_tiles();
+    pool.run(regions.size(), [this](size_t r) { move_region(regions[r]); });
+
+    for (const auto &region : regions) {
+        for (World::index_t index : region.migrations) {
+            spatial_grid.move(index, world.x(index), world.y(index));
         }
-        
-        if (has_fight) {
-            process_fight(fight.attacker, fight.defender);
+    }
+
+    assign_tiles();
+    pool.run(regions.size(), [this](size_t r) { fight_region(regions[r]); });
+
+    size_t fights = 0;
+    for (const auto &region : regions) {
+        fights += region.fights;
+        pending_fights.insert(pending_fights.end(),
+                              region.handoff.begin(), region.handoff.end());
+    }
+    fights += pending_fights.size();
+
+    if (inline_fights) {
+        for (const auto &fight : pending_fights) {
+            process_fight(fight, handoff_log);
         }
+        pending_fights.clear();
+    } else {
+        publish_fights();
     }
+
+    deliver_tick();
+    compact_world();
+    ++tick;
+    // Capturing copies the whole world, and the map reader only draws once a
+    // second; skip the copy on every tick that cannot be the one it shows.
+    if (renderer && frame_due()) publish_snapshot();
+
+    auto &m = metrics.slot(Metrics::MoveSlot);
+    m.tick_time.record_ns(elapsed_ns(started));
+    bump(m.ticks);
+    return fights;
 }
 
-void Game::print_map() {
-    const int CELL = 10;
-    std::vector<std::vector<char>> grid(MAP_SIZE / CELL, 
-                                        std::vector<char>(MAP_SIZE / CELL, '.'));
-    
+void Game::stop() {
+    running = false;
     {
-        std::shared_lock lock(npcs_mutex);
-        
-        for (const auto& npc : npcs) {
-            if (!npc->is_alive()) continue;
-            
-            int gx = npc->get_x() / CELL;
-            int gy = npc->get_y() / CELL;
-            
-            if (gx >= 0 && gx < grid[0].size() && gy >= 0 && gy < grid.size()) {
-                char symbol = '.';
-                switch (npc->get_type()) {
-                    case DruidType: symbol = 'D'; break;
-                    case SquirrelType: symbol = 'S'; break;
-                    case WerewolfType: symbol = 'W'; break;
-                }
-                grid[gy][gx] = symbol;
-            }
+        // Waiters check `running` under queue_mutex; taking it here means
+        // none of them can miss the notification below.
+        std::lock_guard lock(queue_mutex);
+    }
+    queue_cv.notify_all();
+    idle_cv.notify_all();
+}
+
+void Game::move_worker() {
+    auto &m = metrics.slot(Metrics::MoveSlot);
+    TickScheduler scheduler(std::chrono::milliseconds(config.tick_ms), MAX_CATCH_UP);
+
+    while (running) {
+        std::uint64_t due = scheduler.wait(running);
+        for (std::uint64_t i = 0; i < due && running; ++i) {
+            run_tick(false);
         }
+        m.ticks_skipped.store(scheduler.skipped(), std::memory_order_relaxed);
     }
-    
+}
+
+size_t Game::step() {
+    return run_tick(true);
+}
+
+void Game::account(TickLog &log, ThreadMetrics &m) {
+    bump(m.fights_resolved, log.resolved);
+    for (int t = 0; t < NPC_TYPE_COUNT; ++t) {
+        bump(m.kills[t], log.kills[t]);
+        log.kills[t] = 0;
+    }
+    if (log.cout_waits > 0) {
+        bump(m.lock_waits[CoutLock], log.cout_waits);
+        bump(m.lock_wait_ns[CoutLock], log.cout_wait_ns);
+    }
+    log.resolved = 0;
+    log.cout_waits = 0;
+    log.cout_wait_ns = 0;
+}
+
+void Game::deliver_tick() {
+    auto &m = metrics.slot(Metrics::MoveSlot);
+    for (auto &region : regions) {
+        if (journal) journal->append(region.log.events.data(), region.log.events.size());
+        bus.publish(region.log.notices.data(), region.log.notices.size());
+        account(region.log, m);
+        retire_killed(region.log);
+    }
+
+    auto lock = timed_lock<std::unique_lock<std::mutex>>(queue_mutex, m, QueueLock);
+    account(handoff_log, m);
+    if (journal) journal->append(handoff_log.events.data(), handoff_log.events.size());
+    bus.publish(handoff_log.notices.data(), handoff_log.notices.size());
+    retire_killed(handoff_log);
+    handoff_log.events.clear();
+    handoff_log.notices.clear();
+}
+
+void Game::retire_killed(TickLog &log) {
+    // The dead stay in their tiles until compaction but no longer keep them
+    // awake. Fights run on several threads, so this waits for the tick's end.
+    for (World::index_t index : log.killed) {
+        spatial_grid.deactivate(index);
+    }
+    log.killed.clear();
+}
+
+void Game::compact_world() {
+    // Only safe once every fight of the tick has resolved; drop the dead in
+    // one pass when they make up a noticeable share of the population.
+    if (!running) return;
     {
-        std::lock_guard lock(cout_mutex);
-        
-        int alive = 0;
+        auto lock = timed_lock<std::unique_lock<std::mutex>>(
+            queue_mutex, metrics.slot(Metrics::MoveSlot), QueueLock);
+        if (fights_in_flight > 0) return;
+    }
+    if (world.dead() == 0 || world.dead() * COMPACT_RATIO < world.size()) return;
+
+    world.compact(remap);
+    spatial_grid.remap(remap);
+}
+
+void Game::publish_snapshot() {
+    world.capture(snapshots.begin_write(), tick);
+    snapshots.publish();
+}
+
+bool Game::frame_due() const {
+    auto due = next_frame.load(std::memory_order_relaxed) - std::chrono::milliseconds(config.tick_ms);
+    return std::chrono::steady_clock::now() >= due;
+}
+
+void Game::publish_fights() {
+    if (pending_fights.empty()) return;
+
+    // Count fights as in flight before they become visible to fight_worker,
+    // otherwise a drain can race ahead of the increment and the tick never settles.
+    auto &m = metrics.slot(Metrics::MoveSlot);
+    {
+        auto lock = timed_lock<std::unique_lock<std::mutex>>(queue_mutex, m, QueueLock);
+        fights_in_flight += pending_fights.size();
+    }
+    queue_cv.notify_one();
+
+    size_t accepted = fight_queue.publish(pending_fights, running);
+
+    std::uint64_t depth = fight_queue.size();
+    m.queue_depth.store(depth, std::memory_order_relaxed);
+    if (depth > m.queue_depth_max.load(std::memory_order_relaxed)) {
+        m.queue_depth_max.store(depth, std::memory_order_relaxed);
+    }
+    size_t rejected = pending_fights.size() - accepted;
+    pending_fights.clear();
+
+    auto lock = timed_lock<std::unique_lock<std::mutex>>(queue_mutex, m, QueueLock);
+    fights_in_flight -= rejected;
+    // On stop, fights may be left in the queue, but the batch fight_worker
+    // holds must finish before the tick goes on to touch the world.
+    idle_cv.wait(lock, [this]() { return fights_in_flight == 0 || (!running && !fight_busy); });
+}
+
+void Game::fight_worker() {
+    std::vector<Fight> batch(FIGHT_BATCH);
+    TickLog log;
+    auto &m = metrics.slot(Metrics::FightSlot);
+
+    while (running) {
+        size_t count;
         {
-            std::shared_lock lock(npcs_mutex);
-            for (const auto& npc : npcs) {
-                if (npc->is_alive()) alive++;
+            // Draining under the lock lets publish_fights tell an idle worker
+            // from one that still holds a batch.
+            auto lock = timed_lock<std::unique_lock<std::mutex>>(queue_mutex, m, QueueLock);
+            count = fight_queue.drain(batch.data(), batch.size());
+            fight_busy = count > 0;
+
+            if (count == 0) {
+                if (fights_in_flight > 0) {
+                    // publish_fights is still pushing this tick; it does not signal per batch.
+                    lock.unlock();
+                    std::this_thread::yield();
+                    continue;
+                }
+                queue_cv.wait(lock, [this]() {
+                    return fights_in_flight > 0 || !fight_queue.empty() || !running;
+                });
+                continue;
             }
         }
-        
-        std::cout << "\nAlive: " << alive << std::endl;
-        
-        for (const auto& row : grid) {
-            for (char cell : row) {
-                std::cout << cell;
-            }
-            std::cout << std::endl;
+
+
+        for (size_t i = 0; i < count; ++i) {
+            process_fight(batch[i], log);
         }
+        account(log, m);
+
+        auto lock = timed_lock<std::unique_lock<std::mutex>>(queue_mutex, m, QueueLock);
+        handoff_log.events.insert(handoff_log.events.end(), log.events.begin(), log.events.end());
+        handoff_log.notices.insert(handoff_log.notices.end(), log.notices.begin(), log.notices.end());
+        handoff_log.killed.insert(handoff_log.killed.end(), log.killed.begin(), log.killed.end());
+        log.events.clear();
+        log.notices.clear();
+        log.killed.clear();
+        fights_in_flight -= std::min(fights_in_flight, count);
+        fight_busy = false;
+        if (fights_in_flight == 0 || !running) idle_cv.notify_all();
     }
 }
 
+void Game::print_map() {
+    auto &m = metrics.slot(Metrics::MainSlot);
+    auto started = metrics_clock::now();
+
+    auto snapshot = snapshots.acquire();
+    const std::string &frame = renderer->render(*snapshot);
+    m.render_time.record_ns(elapsed_ns(started));
+    if (frame.empty()) return;
+
+    auto lock = timed_lock<std::unique_lock<std::mutex>>(cout_mutex, m, CoutLock);
+    std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    std::cout.flush();
+}
+
 void Game::print_survivors() {
+    auto snapshot = snapshots.acquire();
     std::lock_guard lock(cout_mutex);
     
     std::cout << "\nSurvivors:" << std::endl;
     
-    std::shared_lock npc_lock(npcs_mutex);
-    int count = 0;
-    
-    for (const auto& npc : npcs) {
-        if (npc->is_alive()) {
+    if (config.headless) {
+        std::cout << "Squirrel: " << snapshot->alive_by_type[SquirrelType] << std::endl;
+        std::cout << "Werewolf: " << snapshot->alive_by_type[WerewolfType] << std::endl;
+        std::cout << "Druid: " << snapshot->alive_by_type[DruidType] << std::endl;
+    } else {
+        for (size_t i = 0; i < snapshot->size(); ++i) {
+            if (!snapshot->alive_flags[i]) continue;
+
             std::string type;
-            switch (npc->get_type()) {
+            switch (snapshot->types[i]) {
                 case DruidType: type = "Druid"; break;
                 case SquirrelType: type = "Squirrel"; break;
                 case WerewolfType: type = "Werewolf"; break;
+                default: break;
             }
-            std::cout << type << " " << npc->get_name() 
-                      << " (" << npc->get_x() << ", " << npc->get_y() << ")" << std::endl;
-            count++;
+            std::cout << type << " " << names.get(snapshot->name_ids[i])
+                      << " (" << snapshot->xs[i] << ", " << snapshot->ys[i] << ")" << std::endl;
         }
     }
     
-    std::cout << "Total: " << count << std::endl;
+    std::cout << "Total: " << snapshot->alive << std::endl;
 }
 
-void Game::run() {
+void Game::print_queue_stats() {
+    std::lock_guard lock(cout_mutex);
+
+    auto stats = fight_queue.stats();
+    std::cout << "Fights enqueued: " << stats.enqueued
+              << ", dropped: " << stats.dropped << std::endl;
+}
+
+MetricsSnapshot Game::collect_metrics() const {
+    MetricsSnapshot m = metrics.collect();
+    auto stats = fight_queue.stats();
+    m.enqueued = stats.enqueued;
+    m.dropped = stats.dropped;
+    return m;
+}
+
+void Game::export_metrics() {
+    if (!exporter) return;
+
+    auto m = collect_metrics();
+    exporter->write(m);
+}
+
+void Game::print_metrics_summary() {
+    auto summary = format_summary(collect_metrics());
+    std::lock_guard lock(cout_mutex);
+    std::cout << summary;
+}
+
+std::uint64_t Game::get_seed() const {
+    return seed;
+}
+
+size_t Game::survivors(NpcType type) const {
+    return world.alive(type);
+}
+
+void Game::run_realtime() {
     move_thread = std::thread(&Game::move_worker, this);
     fight_thread = std::thread(&Game::fight_worker, this);
     
-    auto start = std::chrono::steady_clock::now();
+    auto now = std::chrono::steady_clock::now();
+    auto end = now + std::chrono::seconds(config.game_time);
+    auto next_report = now;
     
-    while (running) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - start);
-        
-        if (elapsed.count() >= GAME_TIME) {
-            running = false;
-            break;
+    while (running && now < end) {
+        if (now >= next_report) {
+            if (!config.headless) {
+                print_map();
+            }
+            export_metrics();
+            next_report += REPORT_INTERVAL;
+            next_frame.store(next_report, std::memory_order_relaxed);
         }
-        
-        print_map();
-        std::this_thread::sleep_for(1s);
+        std::this_thread::sleep_until(std::min(next_report, end));
+        now = std::chrono::steady_clock::now();
     }
     
-    queue_cv.notify_all();
+    stop();
     
     if (move_thread.joinable()) move_thread.join();
     if (fight_thread.joinable()) fight_thread.join();
+}
+
+void Game::run_turbo() {
+    auto next_report = std::chrono::steady_clock::now();
+    // Ticks run on this thread, so capture right before drawing instead.
+    next_frame.store(std::chrono::steady_clock::time_point::max(), std::memory_order_relaxed);
+
+    for (std::uint64_t t = 0; t < config.turbo_ticks && running; ++t) {
+        step();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_report) {
+            if (!config.headless) {
+                publish_snapshot();
+                print_map();
+            }
+            export_metrics();
+            next_report = now + REPORT_INTERVAL;
+        }
+    }
+}
+
+void Game::run() {
+    {
+        std::lock_guard lock(cout_mutex);
+        std::cout << "Seed: " << seed << ", map: " << config.map_size
+                  << ", NPCs: " << world.size() << std::endl;
+    }
+
+    if (config.turbo_ticks > 0) {
+        run_turbo();
+    } else {
+        run_realtime();
+    }
     
+    publish_snapshot();
+    flush_logs();
+    if (journal) journal->flush();
     print_survivors();
+    print_queue_stats();
+    export_metrics();
+    print_metrics_summary();
 }
\ No newline at end of file
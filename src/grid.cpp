@@ -0,0 +1,196 @@
+#include "grid.h"
+
+SpatialGrid::SpatialGrid(int map_size, int cell_size)
+    : map_size(std::max(1, map_size)), cell_size(std::max(1, cell_size))
+{
+    long long count = (static_cast<long long>(this->map_size) + this->cell_size - 1) / this->cell_size;
+    cols = static_cast<int>(std::max(1LL, count));
+}
+
+int SpatialGrid::cell_coord(long long v) const {
+    v = std::max(0LL, std::min(static_cast<long long>(map_size) - 1, v));
+    return static_cast<int>(v / cell_size);
+}
+
+std::uint64_t SpatialGrid::key(int tx, int ty) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(ty)) << 32)
+         | static_cast<std::uint32_t>(tx);
+}
+
+const SpatialGrid::Tile *SpatialGrid::find(int tx, int ty) const {
+    auto it = tile_ids.find(key(tx, ty));
+    return it == tile_ids.end() ? nullptr : &tiles[it->second];
+}
+
+SpatialGrid::tile_id SpatialGrid::acquire(int tx, int ty) {
+    auto [it, inserted] = tile_ids.try_emplace(key(tx, ty), 0);
+    if (!inserted) return it->second;
+
+    tile_id t;
+    if (!free_tiles.empty()) {
+        t = free_tiles.back();
+        free_tiles.pop_back();
+    } else {
+        t = static_cast<tile_id>(tiles.size());
+        tiles.emplace_back();
+    }
+    tiles[t].tx = tx;
+    tiles[t].ty = ty;
+    it->second = t;
+    return t;
+}
+
+void SpatialGrid::release(tile_id t) {
+    Tile &tile = tiles[t];
+    set_awake(t, false);
+    tile_ids.erase(key(tile.tx, tile.ty));
+    tile.active = 0;
+    free_tiles.push_back(t);
+}
+
+void SpatialGrid::set_awake(tile_id t, bool on) {
+    Tile &tile = tiles[t];
+    if (on == (tile.awake_slot != NO_SLOT)) return;
+
+    if (on) {
+        tile.awake_slot = static_cast<std::uint32_t>(awake.size());
+        awake.push_back(t);
+        return;
+    }
+
+    tile_id last = awake.back();
+    awake[tile.awake_slot] = last;
+    tiles[last].awake_slot = tile.awake_slot;
+    awake.pop_back();
+    tile.awake_slot = NO_SLOT;
+}
+
+void SpatialGrid::attach(World::index_t index, tile_id t, int x, int y) {
+    Tile &tile = tiles[t];
+    tile_of[index] = t;
+    slot_of[index] = static_cast<std::uint32_t>(tile.members.size());
+    tile.members.push_back(index);
+    tile.xs.push_back(x);
+    tile.ys.push_back(y);
+
+    if (active_of[index] && tile.active++ == 0) set_awake(t, true);
+}
+
+void SpatialGrid::detach(World::index_t index) {
+    tile_id t = tile_of[index];
+    Tile &tile = tiles[t];
+    std::uint32_t slot = slot_of[index];
+    std::uint32_t last = static_cast<std::uint32_t>(tile.members.size() - 1);
+
+    if (slot != last) {
+        tile.members[slot] = tile.members[last];
+        tile.xs[slot] = tile.xs[last];
+        tile.ys[slot] = tile.ys[last];
+        slot_of[tile.members[slot]] = slot;
+    }
+    tile.members.pop_back();
+    tile.xs.pop_back();
+    tile.ys.pop_back();
+
+    if (active_of[index] && --tile.active == 0) set_awake(t, false);
+    if (tile.members.empty()) release(t);
+}
+
+void SpatialGrid::insert(World::index_t index, int x, int y, bool active) {
+    if (index >= tile_of.size()) {
+        tile_of.resize(index + 1, 0);
+        slot_of.resize(index + 1, 0);
+        active_of.resize(index + 1, 0);
+    }
+    active_of[index] = active ? 1 : 0;
+    attach(index, acquire(cell_coord(x), cell_coord(y)), x, y);
+}
+
+void SpatialGrid::move(World::index_t index, int new_x, int new_y) {
+    Tile &tile = tiles[tile_of[index]];
+    int tx = cell_coord(new_x);
+    int ty = cell_coord(new_y);
+
+    if (tile.tx == tx && tile.ty == ty) {
+        tile.xs[slot_of[index]] = new_x;
+        tile.ys[slot_of[index]] = new_y;
+        return;
+    }
+
+    detach(index);
+    attach(index, acquire(tx, ty), new_x, new_y);
+}
+
+void SpatialGrid::deactivate(World::index_t index) {
+    if (!active_of[index]) return;
+
+    active_of[index] = 0;
+    tile_id t = tile_of[index];
+    if (--tiles[t].active == 0) set_awake(t, false);
+}
+
+void SpatialGrid::remap(const std::vector<World::index_t> &new_index) {
+    std::vector<std::uint8_t> old_active;
+    old_active.swap(active_of);
+
+    size_t count = 0;
+    for (World::index_t mapped : new_index) {
+        if (mapped != World::INVALID_INDEX) count = std::max<size_t>(count, mapped + 1);
+    }
+    tile_of.assign(count, 0);
+    slot_of.assign(count, 0);
+    active_of.assign(count, 0);
+
+    for (tile_id t = 0; t < tiles.size(); ++t) {
+        Tile &tile = tiles[t];
+        if (tile.members.empty()) continue;
+
+        size_t out = 0;
+        tile.active = 0;
+        for (size_t k = 0; k < tile.members.size(); ++k) {
+            World::index_t old = tile.members[k];
+            World::index_t mapped = new_index[old];
+            if (mapped == World::INVALID_INDEX) continue;
+
+            tile.members[out] = mapped;
+            tile.xs[out] = tile.xs[k];
+            tile.ys[out] = tile.ys[k];
+            tile_of[mapped] = t;
+            slot_of[mapped] = static_cast<std::uint32_t>(out);
+            active_of[mapped] = old_active[old];
+            tile.active += old_active[old];
+            ++out;
+        }
+        tile.members.resize(out);
+        tile.xs.resize(out);
+        tile.ys.resize(out);
+
+        if (out == 0) {
+            release(t);
+        } else {
+            set_awake(t, tile.active > 0);
+        }
+    }
+}
+
+void SpatialGrid::clear() {
+    tiles.clear();
+    free_tiles.clear();
+    tile_ids.clear();
+    awake.clear();
+    tile_of.clear();
+    slot_of.clear();
+    active_of.clear();
+}
+
+int SpatialGrid::get_cell_size() const {
+    return cell_size;
+}
+
+int SpatialGrid::get_cols() const {
+    return cols;
+}
+
+int SpatialGrid::column_of(int x) const {
+    return cell_coord(x);
+}
@@ -0,0 +1,91 @@
+#include "journal.h"
+#include <cstring>
+#include <stdexcept>
+
+JournalWriter::JournalWriter(const std::string &filename)
+    : file(filename, std::ios::binary | std::ios::trunc)
+{
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open journal " + filename);
+    }
+
+    JournalHeader header{};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.record_size = sizeof(FightEvent);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    buffer.reserve(BUFFER_SIZE);
+}
+
+JournalWriter::~JournalWriter() {
+    flush();
+}
+
+void JournalWriter::append(const FightEvent *events, size_t count) {
+    const char *bytes = reinterpret_cast<const char *>(events);
+    size_t length = count * sizeof(FightEvent);
+
+    if (buffer.size() + length > BUFFER_SIZE) {
+        flush();
+    }
+
+    if (length >= BUFFER_SIZE) {
+        file.write(bytes, static_cast<std::streamsize>(length));
+    } else {
+        buffer.insert(buffer.end(), bytes, bytes + length);
+    }
+    written += count;
+}
+
+void JournalWriter::flush() {
+    if (!buffer.empty()) {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    file.flush();
+}
+
+std::uint64_t JournalWriter::count() const {
+    return written;
+}
+
+JournalReader::JournalReader(const std::string &filename) : file(filename) {
+    if (file.size() < sizeof(JournalHeader)) {
+        throw std::runtime_error("Invalid journal: " + filename);
+    }
+
+    const auto *header = reinterpret_cast<const JournalHeader *>(file.data());
+    if (std::memcmp(header->magic, JOURNAL_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != JOURNAL_VERSION || header->record_size != sizeof(FightEvent)) {
+        throw std::runtime_error("Invalid journal: " + filename);
+    }
+
+    events = reinterpret_cast<const FightEvent *>(file.data() + sizeof(JournalHeader));
+    count = (file.size() - sizeof(JournalHeader)) / sizeof(FightEvent);
+}
+
+size_t JournalReader::size() const {
+    return count;
+}
+
+const FightEvent *JournalReader::begin() const {
+    return events;
+}
+
+const FightEvent *JournalReader::end() const {
+    return events + count;
+}
+
+const FightEvent &JournalReader::operator[](size_t i) const {
+    return events[i];
+}
+
+const char *outcome_name(FightOutcome outcome) {
+    switch (outcome) {
+        case FightOutcome::Immune: return "immune";
+        case FightOutcome::Missed: return "missed";
+        case FightOutcome::Killed: return "killed";
+    }
+    return "unknown";
+}
\ No newline at end of file
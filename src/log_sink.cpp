@@ -0,0 +1,94 @@
+#include "log_sink.h"
+#include <vector>
+
+KillRecord make_kill_record(const NPC &attacker, const NPC &defender) {
+    return {
+        attacker.get_type(), attacker.get_x(), attacker.get_y(), attacker.get_name(),
+        defender.get_type(), defender.get_x(), defender.get_y(), defender.get_name()
+    };
+}
+
+LogSink::LogSink(std::ostream &out, formatter format, size_t capacity)
+    : out(out), format(format), queue(capacity)
+{
+    thread = std::thread(&LogSink::worker, this);
+}
+
+LogSink::~LogSink() {
+    {
+        std::lock_guard lock(mutex);
+        running = false;
+    }
+    wake_cv.notify_all();
+
+    if (thread.joinable()) thread.join();
+}
+
+void LogSink::post(const KillRecord &record) {
+    while (!queue.push(record)) {
+        wake_cv.notify_one();
+        std::this_thread::yield();
+    }
+    posted.fetch_add(1, std::memory_order_release);
+
+    // Pairs with the fence in worker(): either the worker sees this record
+    // before it sleeps, or we see it asleep and wake it. Only a post that
+    // finds the worker idle pays for the mutex.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard lock(mutex);
+        wake_cv.notify_one();
+    }
+}
+
+void LogSink::flush() {
+    std::uint64_t target = posted.load(std::memory_order_acquire);
+
+    std::unique_lock lock(mutex);
+    wake_cv.notify_one();
+    written_cv.wait(lock, [&]() { return written >= target || !running; });
+}
+
+void LogSink::worker() {
+    std::vector<KillRecord> batch(BATCH);
+    std::string buffer;
+
+    while (true) {
+        size_t count = queue.pop_batch(batch.data(), batch.size());
+
+        if (count == 0) {
+            std::unique_lock lock(mutex);
+            if (!running && queue.empty()) break;
+            sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            wake_cv.wait(lock, [this]() { return !queue.empty() || !running; });
+            sleeping.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        buffer.clear();
+        for (size_t i = 0; i < count; ++i) {
+            format(buffer, batch[i]);
+        }
+
+        size_t more;
+        while (buffer.size() < (1 << 16) &&
+               (more = queue.pop_batch(batch.data(), batch.size())) > 0) {
+            for (size_t i = 0; i < more; ++i) {
+                format(buffer, batch[i]);
+            }
+            count += more;
+        }
+
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.flush();
+
+        {
+            std::lock_guard lock(mutex);
+            written += count;
+        }
+        written_cv.notify_all();
+    }
+
+    written_cv.notify_all();
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "mapped_file.h"
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &filename) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open " + filename);
+    }
+    file_handle = file;
+
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file, &file_size);
+    length = static_cast<size_t>(file_size.QuadPart);
+    if (length == 0) return;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping) {
+        mapping_handle = mapping;
+        bytes = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + filename + ": " + std::strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        length = static_cast<size_t>(st.st_size);
+    }
+    if (length == 0) return;
+
+    void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped != MAP_FAILED) {
+        bytes = static_cast<const char *>(mapped);
+        madvise(mapped, length, MADV_SEQUENTIAL);
+    }
+#endif
+
+    if (!bytes) {
+        unmap();
+        throw std::runtime_error("Cannot map " + filename);
+    }
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+void MappedFile::unmap() {
+#ifdef _WIN32
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mapping_handle) CloseHandle(static_cast<HANDLE>(mapping_handle));
+    if (file_handle) CloseHandle(static_cast<HANDLE>(file_handle));
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+#else
+    if (bytes) munmap(const_cast<char *>(bytes), length);
+    if (fd >= 0) close(fd);
+    fd = -1;
+#endif
+    bytes = nullptr;
+}
+
+const char *MappedFile::data() const {
+    return bytes;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
\ No newline at end of file
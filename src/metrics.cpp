@@ -0,0 +1,203 @@
+#include "metrics.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+static const char *SPECIES[NPC_TYPE_COUNT] = {"unknown", "squirrel", "werewolf", "druid"};
+
+const char *lock_name(LockId lock) {
+    switch (lock) {
+        case QueueLock: return "queue";
+        case CoutLock: return "cout";
+        default: return "unknown";
+    }
+}
+
+std::uint64_t HistogramSnapshot::upper_bound(int bucket) {
+    return std::uint64_t{1} << bucket;
+}
+
+std::uint64_t HistogramSnapshot::percentile(double q) const {
+    if (count == 0) return 0;
+
+    std::uint64_t target = static_cast<std::uint64_t>(q * static_cast<double>(count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen >= target) return upper_bound(b);
+    }
+    return upper_bound(BUCKETS - 1);
+}
+
+void Histogram::record_ns(std::uint64_t ns) {
+    std::uint64_t us = ns / 1000;
+    int bucket = 0;
+    while (bucket < HistogramSnapshot::BUCKETS - 1 && HistogramSnapshot::upper_bound(bucket) < us) {
+        ++bucket;
+    }
+    bump(counts[bucket]);
+    bump(sum_us, us);
+}
+
+void Histogram::merge_into(HistogramSnapshot &out) const {
+    for (int b = 0; b < HistogramSnapshot::BUCKETS; ++b) {
+        std::uint64_t n = counts[b].load(std::memory_order_relaxed);
+        out.counts[b] += n;
+        out.count += n;
+    }
+    out.sum_us += sum_us.load(std::memory_order_relaxed);
+}
+
+MetricsSnapshot Metrics::collect() const {
+    MetricsSnapshot m;
+    m.uptime_s = std::chrono::duration<double>(metrics_clock::now() - started).count();
+
+    for (const auto &s : slots) {
+        s.tick_time.merge_into(m.tick_time);
+        s.render_time.merge_into(m.render_time);
+        m.ticks += s.ticks.load(std::memory_order_relaxed);
+        m.ticks_skipped += s.ticks_skipped.load(std::memory_order_relaxed);
+        m.fights_resolved += s.fights_resolved.load(std::memory_order_relaxed);
+        for (int t = 0; t < NPC_TYPE_COUNT; ++t) {
+            m.kills[t] += s.kills[t].load(std::memory_order_relaxed);
+        }
+        m.queue_depth += s.queue_depth.load(std::memory_order_relaxed);
+        m.queue_depth_max = std::max(m.queue_depth_max, s.queue_depth_max.load(std::memory_order_relaxed));
+        for (int l = 0; l < LOCK_COUNT; ++l) {
+            m.lock_waits[l] += s.lock_waits[l].load(std::memory_order_relaxed);
+            m.lock_wait_ns[l] += s.lock_wait_ns[l].load(std::memory_order_relaxed);
+        }
+    }
+    return m;
+}
+
+MetricsExporter::MetricsExporter(const std::string &path)
+    : path(path), json(path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0) {}
+
+void MetricsExporter::write(MetricsSnapshot &current) {
+    double interval = current.uptime_s - previous.uptime_s;
+    if (interval > 0) {
+        current.enqueue_rate = static_cast<double>(current.enqueued - previous.enqueued) / interval;
+        current.resolve_rate = static_cast<double>(current.fights_resolved - previous.fights_resolved) / interval;
+    }
+    previous = current;
+
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        out << (json ? format_json(current) : format_prometheus(current));
+    }
+    std::rename(temp.c_str(), path.c_str());
+}
+
+static void histogram_prometheus(std::ostringstream &os, const char *name, const HistogramSnapshot &h) {
+    os << "# TYPE " << name << " histogram\n";
+    std::uint64_t cumulative = 0;
+    for (int b = 0; b < HistogramSnapshot::BUCKETS; ++b) {
+        cumulative += h.counts[b];
+        os << name << "_bucket{le=\"";
+        if (b == HistogramSnapshot::BUCKETS - 1) {
+            os << "+Inf";
+        } else {
+            os << static_cast<double>(HistogramSnapshot::upper_bound(b)) / 1e6;
+        }
+        os << "\"} " << cumulative << '\n';
+    }
+    os << name << "_sum " << static_cast<double>(h.sum_us) / 1e6 << '\n';
+    os << name << "_count " << h.count << '\n';
+}
+
+std::string format_prometheus(const MetricsSnapshot &m) {
+    std::ostringstream os;
+    os << "# TYPE lab07_uptime_seconds gauge\nlab07_uptime_seconds " << m.uptime_s << '\n';
+    os << "# TYPE lab07_ticks_total counter\nlab07_ticks_total " << m.ticks << '\n';
+    os << "# TYPE lab07_ticks_skipped_total counter\nlab07_ticks_skipped_total " << m.ticks_skipped << '\n';
+    histogram_prometheus(os, "lab07_tick_duration_seconds", m.tick_time);
+    histogram_prometheus(os, "lab07_render_duration_seconds", m.render_time);
+
+    os << "# TYPE lab07_fight_queue_depth gauge\nlab07_fight_queue_depth " << m.queue_depth << '\n';
+    os << "# TYPE lab07_fight_queue_depth_max gauge\nlab07_fight_queue_depth_max " << m.queue_depth_max << '\n';
+    os << "# TYPE lab07_fights_enqueued_total counter\nlab07_fights_enqueued_total " << m.enqueued << '\n';
+    os << "# TYPE lab07_fights_dropped_total counter\nlab07_fights_dropped_total " << m.dropped << '\n';
+    os << "# TYPE lab07_fights_resolved_total counter\nlab07_fights_resolved_total " << m.fights_resolved << '\n';
+    os << "# TYPE lab07_fights_enqueued_per_second gauge\nlab07_fights_enqueued_per_second " << m.enqueue_rate << '\n';
+    os << "# TYPE lab07_fights_resolved_per_second gauge\nlab07_fights_resolved_per_second " << m.resolve_rate << '\n';
+
+    os << "# TYPE lab07_kills_total counter\n";
+    for (int t = 1; t < NPC_TYPE_COUNT; ++t) {
+        os << "lab07_kills_total{species=\"" << SPECIES[t] << "\"} " << m.kills[t] << '\n';
+    }
+
+    os << "# TYPE lab07_lock_waits_total counter\n";
+    for (int l = 0; l < LOCK_COUNT; ++l) {
+        os << "lab07_lock_waits_total{lock=\"" << lock_name(static_cast<LockId>(l)) << "\"} "
+           << m.lock_waits[l] << '\n';
+    }
+    os << "# TYPE lab07_lock_wait_seconds_total counter\n";
+    for (int l = 0; l < LOCK_COUNT; ++l) {
+        os << "lab07_lock_wait_seconds_total{lock=\"" << lock_name(static_cast<LockId>(l)) << "\"} "
+           << static_cast<double>(m.lock_wait_ns[l]) / 1e9 << '\n';
+    }
+    return os.str();
+}
+
+static void histogram_json(std::ostringstream &os, const HistogramSnapshot &h) {
+    os << "{\"count\": " << h.count << ", \"sum_us\": " << h.sum_us
+       << ", \"p50_us\": " << h.percentile(0.5) << ", \"p99_us\": " << h.percentile(0.99)
+       << ", \"buckets_us\": [";
+    for (int b = 0; b < HistogramSnapshot::BUCKETS; ++b) {
+        os << (b ? ", " : "") << h.counts[b];
+    }
+    os << "]}";
+}
+
+std::string format_json(const MetricsSnapshot &m) {
+    std::ostringstream os;
+    os << "{\n  \"uptime_s\": " << m.uptime_s
+       << ",\n  \"ticks\": " << m.ticks
+       << ",\n  \"ticks_skipped\": " << m.ticks_skipped
+       << ",\n  \"tick_time\": ";
+    histogram_json(os, m.tick_time);
+    os << ",\n  \"render_time\": ";
+    histogram_json(os, m.render_time);
+    os << ",\n  \"queue_depth\": " << m.queue_depth
+       << ",\n  \"queue_depth_max\": " << m.queue_depth_max
+       << ",\n  \"fights_enqueued\": " << m.enqueued
+       << ",\n  \"fights_dropped\": " << m.dropped
+       << ",\n  \"fights_resolved\": " << m.fights_resolved
+       << ",\n  \"enqueue_rate\": " << m.enqueue_rate
+       << ",\n  \"resolve_rate\": " << m.resolve_rate
+       << ",\n  \"kills\": {";
+    for (int t = 1; t < NPC_TYPE_COUNT; ++t) {
+        os << (t > 1 ? ", " : "") << '"' << SPECIES[t] << "\": " << m.kills[t];
+    }
+    os << "},\n  \"lock_wait_ns\": {";
+    for (int l = 0; l < LOCK_COUNT; ++l) {
+        os << (l ? ", " : "") << '"' << lock_name(static_cast<LockId>(l)) << "\": " << m.lock_wait_ns[l];
+    }
+    os << "}\n}\n";
+    return os.str();
+}
+
+std::string format_summary(const MetricsSnapshot &m) {
+    std::ostringstream os;
+    double seconds = m.uptime_s > 0 ? m.uptime_s : 1;
+
+    os << "Ticks: " << m.ticks << " (skipped " << m.ticks_skipped << ")"
+       << ", tick p50: " << m.tick_time.percentile(0.5) << "us"
+       << ", p99: " << m.tick_time.percentile(0.99) << "us\n";
+    os << "Fights resolved: " << m.fights_resolved
+       << " (" << static_cast<std::uint64_t>(static_cast<double>(m.fights_resolved) / seconds) << "/s)"
+       << ", queue depth max: " << m.queue_depth_max << '\n';
+    os << "Kills: squirrel " << m.kills[SquirrelType]
+       << ", werewolf " << m.kills[WerewolfType]
+       << ", druid " << m.kills[DruidType] << '\n';
+    os << "Lock wait:";
+    for (int l = 0; l < LOCK_COUNT; ++l) {
+        os << (l ? ", " : " ") << lock_name(static_cast<LockId>(l)) << ' '
+           << m.lock_wait_ns[l] / 1000 << "us";
+    }
+    os << '\n';
+    return os.str();
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "name_table.h"
+#include <cstring>
+#include <mutex>
+
+NameTable &NameTable::global() {
+    static NameTable table;
+    return table;
+}
+
+std::string_view NameTable::store(std::string_view name) {
+    if (name.empty()) return {};
+
+    char *dst;
+    if (name.size() > BLOCK_SIZE / 4) {
+        blocks.push_back(std::make_unique<char[]>(name.size()));
+        dst = blocks.back().get();
+    } else {
+        if (block_used + name.size() > BLOCK_SIZE) {
+            blocks.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+            current = blocks.back().get();
+            block_used = 0;
+        }
+        dst = current + block_used;
+        block_used += name.size();
+    }
+
+    std::memcpy(dst, name.data(), name.size());
+    return std::string_view(dst, name.size());
+}
+
+NameTable::name_id NameTable::intern(std::string_view name) {
+    {
+        std::shared_lock lock(mutex);
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+    }
+
+    std::unique_lock lock(mutex);
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+
+    std::string_view stored = store(name);
+    name_id id = static_cast<name_id>(names.size());
+    names.push_back(stored);
+    ids.emplace(stored, id);
+    return id;
+}
+
+std::string_view NameTable::get(name_id id) const {
+    std::shared_lock lock(mutex);
+    return names[id];
+}
+
+size_t NameTable::size() const {
+    std::shared_lock lock(mutex);
+    return names.size();
+}
\ No newline at end of file
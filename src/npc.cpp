@@ -2,39 +2,54 @@
 #include "squirrel.h"
 #include "werewolf.h"
 #include "druid.h"
+#include "combat.h"
+#include "event_bus.h"
+#include "range_query.h"
+#include <algorithm>
+#include <climits>
 
-NPC::NPC(NpcType t, int _x, int _y, const std::string& _name) 
-    : type(t), x(_x), y(_y), name(_name), alive(true) 
+NPC::NPC(NpcType t, int _x, int _y, std::string_view _name, int limit, NameTable &names)
+    : type(t), x(_x), y(_y), name_id(names.intern(_name)), name(names.get(name_id)), alive(true)
 {
-    if (x < 0 || x > 500 || y < 0 || y > 500) {
-        throw std::runtime_error("Coordinates must be in range 0-500");
+    if (x < 0 || x > limit || y < 0 || y > limit) {
+        throw std::runtime_error("Coordinates must be in range 0-" + std::to_string(limit));
     }
 }
 
-NPC::NPC(NpcType t, std::istream &is) : type(t), alive(true) {
+NPC::NPC(NpcType t, std::istream &is, int limit) : type(t), alive(true) {
+    std::string buffer;
     is >> x;
     is >> y;
-    is >> name;
+    is >> buffer;
+    name_id = NameTable::global().intern(buffer);
+    name = NameTable::global().get(name_id);
     
-    if (x < 0 || x > 500 || y < 0 || y > 500) {
-        throw std::runtime_error("Coordinates must be in range 0-500");
+    if (x < 0 || x > limit || y < 0 || y > limit) {
+        throw std::runtime_error("Coordinates must be in range 0-" + std::to_string(limit));
     }
 }
 
-void NPC::subscribe(std::shared_ptr<IFightObserver> observer) {
-    observers.push_back(observer);
+bool NPC::fight_with(const std::shared_ptr<NPC> &other) {
+    bool win = can_kill(type, other->type);
+    EventBus::global().publish({this, other.get(), win});
+    return win;
 }
 
-void NPC::fight_notify(const std::shared_ptr<NPC> defender, bool win) {
-    for (auto &o : observers) {
-        o->on_fight(shared_from_this(), defender, win);
-    }
+bool NPC::fight(std::shared_ptr<Squirrel> other) {
+    return fight_with(other);
+}
+
+bool NPC::fight(std::shared_ptr<Werewolf> other) {
+    return fight_with(other);
+}
+
+bool NPC::fight(std::shared_ptr<Druid> other) {
+    return fight_with(other);
 }
 
 bool NPC::is_close(const std::shared_ptr<NPC> &other, size_t distance) const {
-    int dx = x - other->x;
-    int dy = y - other->y;
-    return (dx*dx + dy*dy) <= (distance * distance);
+    int radius = static_cast<int>(std::min<size_t>(distance, INT_MAX));
+    return within(x, y, other->x, other->y, radius);
 }
 
 void NPC::set_position(int new_x, int new_y) {
@@ -62,14 +77,18 @@ int NPC::get_y() const {
     return y;
 }
 
-std::string NPC::get_name() const {
+std::string_view NPC::get_name() const {
     return name;
 }
 
+NameTable::name_id NPC::get_name_id() const {
+    return name_id;
+}
+
 void NPC::save(std::ostream &os) {
-    os << x << std::endl;
-    os << y << std::endl;
-    os << name << std::endl;
+    os << x << '\n';
+    os << y << '\n';
+    os << name << '\n';
 }
 
 std::ostream &operator<<(std::ostream &os, NPC &npc) {
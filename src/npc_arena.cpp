@@ -0,0 +1,58 @@
+#include "npc_arena.h"
+#include <cstdint>
+
+NpcArena::NpcArena(size_t reserve_bytes) {
+    if (reserve_bytes > 0) {
+        // Plain new[] leaves the storage uninitialised; make_unique would zero it.
+        blocks.emplace_back(new std::byte[reserve_bytes]);
+        current = blocks.back().get();
+        block_size = reserve_bytes;
+    }
+}
+
+void *NpcArena::allocate(size_t bytes, size_t alignment) {
+    std::lock_guard lock(mutex);
+
+    for (auto &[size, list] : free_lists) {
+        if (size == bytes && !list.empty() &&
+            reinterpret_cast<std::uintptr_t>(list.back()) % alignment == 0) {
+            void *p = list.back();
+            list.pop_back();
+            return p;
+        }
+    }
+
+    size_t offset = (used + alignment - 1) & ~(alignment - 1);
+    if (!current || offset + bytes > block_size) {
+        block_size = bytes > BLOCK_SIZE ? bytes : BLOCK_SIZE;
+        blocks.emplace_back(new std::byte[block_size]);
+        current = blocks.back().get();
+        offset = 0;
+    }
+
+    used = offset + bytes;
+    allocated += bytes;
+    return current + offset;
+}
+
+void NpcArena::deallocate(void *p, size_t bytes) {
+    std::lock_guard lock(mutex);
+
+    for (auto &[size, list] : free_lists) {
+        if (size == bytes) {
+            list.push_back(p);
+            return;
+        }
+    }
+    free_lists.push_back({bytes, {p}});
+}
+
+size_t NpcArena::bytes_allocated() {
+    std::lock_guard lock(mutex);
+    return allocated;
+}
+
+size_t NpcArena::block_count() {
+    std::lock_guard lock(mutex);
+    return blocks.size();
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "npc_stream.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+#include <charconv>
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+constexpr size_t FIELDS_PER_NPC = 4;
+
+bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+const char *skip_space(const char *p, const char *end) {
+    while (p < end && is_space(*p)) ++p;
+    return p;
+}
+
+const char *skip_token(const char *p, const char *end) {
+    while (p < end && !is_space(*p)) ++p;
+    return p;
+}
+
+size_t count_tokens(const char *begin, const char *end) {
+    size_t tokens = 0;
+    for (const char *p = skip_space(begin, end); p < end; p = skip_space(p, end)) {
+        p = skip_token(p, end);
+        ++tokens;
+    }
+    return tokens;
+}
+
+bool parse_int(std::string_view token, int &value) {
+    auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    return ec == std::errc() && ptr == token.data() + token.size();
+}
+
+struct Chunk {
+    const char *begin;
+    const char *end;
+    size_t tokens_before;
+    size_t tokens;
+    std::vector<NpcEntry> entries;
+    size_t errors;
+};
+
+void parse_chunk(Chunk &chunk, const char *file_end, size_t expected) {
+    chunk.entries.clear();
+    chunk.errors = 0;
+
+    size_t token = chunk.tokens_before;
+    const char *p = skip_space(chunk.begin, file_end);
+
+    while (p < chunk.end) {
+        if (token == 0 || (token - 1) % FIELDS_PER_NPC != 0) {
+            p = skip_space(skip_token(p, file_end), file_end);
+            ++token;
+            continue;
+        }
+
+        if ((token - 1) / FIELDS_PER_NPC >= expected) break;
+
+        std::string_view fields[FIELDS_PER_NPC];
+        size_t read = 0;
+        for (; read < FIELDS_PER_NPC && p < file_end; ++read) {
+            const char *start = p;
+            p = skip_token(p, file_end);
+            fields[read] = std::string_view(start, p - start);
+            p = skip_space(p, file_end);
+        }
+        token += read;
+
+        NpcEntry entry{Unknown, 0, 0, fields[3]};
+        int type = 0;
+        if (read == FIELDS_PER_NPC && parse_int(fields[0], type) &&
+            type >= SquirrelType && type <= DruidType &&
+            parse_int(fields[1], entry.x) && parse_int(fields[2], entry.y)) {
+            entry.type = static_cast<NpcType>(type);
+            chunk.entries.push_back(entry);
+        } else {
+            chunk.errors++;
+        }
+    }
+}
+
+}
+
+StreamResult stream_npcs(const std::string &filename, const npc_callback &callback,
+                         size_t threads, size_t chunk_size) {
+    StreamResult result{0, 0, 0};
+
+    MappedFile file(filename);
+    const char *data = file.data();
+    const char *end = data + file.size();
+    if (!data) return result;
+
+    const char *header = skip_space(data, end);
+    const char *header_end = skip_token(header, end);
+    int expected = 0;
+    if (!parse_int(std::string_view(header, header_end - header), expected) || expected < 0) {
+        result.errors = 1;
+        return result;
+    }
+    result.expected = static_cast<size_t>(expected);
+
+    std::vector<const char *> bounds = {data};
+    chunk_size = std::max<size_t>(chunk_size, 1);
+    while (bounds.back() < end) {
+        const char *next = bounds.back() + std::min<size_t>(chunk_size, end - bounds.back());
+        while (next < end && !is_space(*next)) ++next;
+        bounds.push_back(next);
+    }
+
+    ThreadPool pool(std::max<size_t>(threads, 1));
+    std::vector<Chunk> wave(pool.size());
+    size_t tokens_seen = 0;
+
+    for (size_t first = 0; first + 1 < bounds.size(); first += wave.size()) {
+        size_t count = std::min(wave.size(), bounds.size() - 1 - first);
+
+        for (size_t i = 0; i < count; ++i) {
+            wave[i].begin = bounds[first + i];
+            wave[i].end = bounds[first + i + 1];
+        }
+
+        pool.run(count, [&](size_t i) {
+            wave[i].tokens = count_tokens(wave[i].begin, wave[i].end);
+        });
+
+        for (size_t i = 0; i < count; ++i) {
+            wave[i].tokens_before = tokens_seen;
+            tokens_seen += wave[i].tokens;
+        }
+
+        pool.run(count, [&](size_t i) {
+            parse_chunk(wave[i], end, result.expected);
+        });
+
+        for (size_t i = 0; i < count; ++i) {
+            for (const auto &entry : wave[i].entries) {
+                callback(entry);
+            }
+            result.loaded += wave[i].entries.size();
+            result.errors += wave[i].errors;
+        }
+    }
+
+    size_t accounted = result.loaded + result.errors;
+    if (accounted < result.expected) {
+        result.errors += result.expected - accounted;
+    }
+
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "random.h"
+#include <random>
+
+namespace {
+
+constexpr std::uint32_t PHILOX_M0 = 0xD2511F53;
+constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57;
+constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9;
+constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85;
+constexpr int PHILOX_ROUNDS = 10;
+
+}
+
+RandomStream::RandomStream(std::uint64_t seed, RngPurpose purpose,
+                           std::uint32_t tick, std::uint32_t a, std::uint32_t b)
+    : counter{tick, a, b, 0},
+      key{static_cast<std::uint32_t>(seed),
+          static_cast<std::uint32_t>(seed >> 32) ^ (static_cast<std::uint32_t>(purpose) * 0x85EBCA6Bu)}
+{}
+
+void RandomStream::refill() {
+    std::array<std::uint32_t, 4> c = counter;
+    std::uint32_t k0 = key[0];
+    std::uint32_t k1 = key[1];
+
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        std::uint64_t p0 = static_cast<std::uint64_t>(PHILOX_M0) * c[0];
+        std::uint64_t p1 = static_cast<std::uint64_t>(PHILOX_M1) * c[2];
+        c = {
+            static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0,
+            static_cast<std::uint32_t>(p1),
+            static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1,
+            static_cast<std::uint32_t>(p0)
+        };
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    block = c;
+    used = 0;
+    ++counter[3];
+}
+
+std::uint32_t RandomStream::next() {
+    if (used == 4) refill();
+    return block[used++];
+}
+
+int RandomStream::uniform(int lo, int hi) {
+    std::uint32_t range = static_cast<std::uint32_t>(hi - lo) + 1;
+    std::uint64_t m = static_cast<std::uint64_t>(next()) * range;
+    std::uint32_t low = static_cast<std::uint32_t>(m);
+
+    if (low < range) {
+        std::uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            m = static_cast<std::uint64_t>(next()) * range;
+            low = static_cast<std::uint32_t>(m);
+        }
+    }
+
+    return lo + static_cast<int>(m >> 32);
+}
+
+std::uint64_t random_seed() {
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "range_query.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LAB07_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+static size_t select_tail(const int *xs, const int *ys, size_t first, size_t count,
+                          int x, int y, int radius, std::uint32_t *out, size_t n) {
+    for (size_t i = first; i < count; ++i) {
+        out[n] = static_cast<std::uint32_t>(i);
+        n += within(xs[i], ys[i], x, y, radius) ? 1 : 0;
+    }
+    return n;
+}
+
+static size_t select_scalar(const int *xs, const int *ys, size_t count,
+                            int x, int y, int radius, std::uint32_t *out) {
+    return select_tail(xs, ys, 0, count, x, y, radius, out, 0);
+}
+
+#ifdef LAB07_X86_KERNELS
+
+// Per-lane "far" bits come out of the 64-bit compares split into even and
+// odd lanes; interleave them back into lane order.
+static inline unsigned spread_bits(unsigned m) {
+    return (m & 1u) | ((m & 2u) << 1) | ((m & 4u) << 2) | ((m & 8u) << 3);
+}
+
+static inline size_t emit_hits(unsigned mask, size_t base, std::uint32_t *out, size_t n) {
+    while (mask) {
+        out[n++] = static_cast<std::uint32_t>(base + __builtin_ctz(mask));
+        mask &= mask - 1;
+    }
+    return n;
+}
+
+// SSE2 has neither a signed 32x32->64 multiply nor a 64-bit compare, so
+// square |d| with the unsigned multiply and build the compare from 32-bit halves.
+__attribute__((target("sse2")))
+static inline __m128i abs_epi32(__m128i v) {
+    __m128i sign = _mm_srai_epi32(v, 31);
+    return _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+}
+
+__attribute__((target("sse2")))
+static inline __m128i squares_epi64(__m128i dx, __m128i dy) {
+    return _mm_add_epi64(_mm_mul_epu32(dx, dx), _mm_mul_epu32(dy, dy));
+}
+
+// Only bit 63 of each lane is meaningful, which is all movemask_pd reads.
+__attribute__((target("sse2")))
+static inline __m128i cmpgt_epi64(__m128i a, __m128i b) {
+    const __m128i bias = _mm_set1_epi32(INT32_MIN);
+    __m128i hi_gt = _mm_cmpgt_epi32(a, b);
+    __m128i hi_eq = _mm_cmpeq_epi32(a, b);
+    __m128i lo_gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+    return _mm_or_si128(hi_gt, _mm_and_si128(hi_eq, _mm_slli_epi64(lo_gt, 32)));
+}
+
+__attribute__((target("sse2")))
+static size_t select_sse2(const int *xs, const int *ys, size_t count,
+                          int x, int y, int radius, std::uint32_t *out) {
+    const __m128i qx = _mm_set1_epi32(x);
+    const __m128i qy = _mm_set1_epi32(y);
+    const __m128i r2 = _mm_set1_epi64x(static_cast<long long>(radius) * radius);
+
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i dx = abs_epi32(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(xs + i)), qx));
+        __m128i dy = abs_epi32(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ys + i)), qy));
+
+        __m128i even = squares_epi64(dx, dy);
+        __m128i odd = squares_epi64(_mm_srli_epi64(dx, 32), _mm_srli_epi64(dy, 32));
+
+        unsigned far_even = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(cmpgt_epi64(even, r2))));
+        unsigned far_odd = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(cmpgt_epi64(odd, r2))));
+        unsigned hits = ~(spread_bits(far_even) | (spread_bits(far_odd) << 1)) & 0xFu;
+        n = emit_hits(hits, i, out, n);
+    }
+    return select_tail(xs, ys, i, count, x, y, radius, out, n);
+}
+
+__attribute__((target("avx2")))
+static size_t select_avx2(const int *xs, const int *ys, size_t count,
+                          int x, int y, int radius, std::uint32_t *out) {
+    const __m256i qx = _mm256_set1_epi32(x);
+    const __m256i qy = _mm256_set1_epi32(y);
+    const __m256i r2 = _mm256_set1_epi64x(static_cast<long long>(radius) * radius);
+
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i dx = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(xs + i)), qx);
+        __m256i dy = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ys + i)), qy);
+
+        __m256i even = _mm256_add_epi64(_mm256_mul_epi32(dx, dx), _mm256_mul_epi32(dy, dy));
+        __m256i dx_odd = _mm256_srli_epi64(dx, 32);
+        __m256i dy_odd = _mm256_srli_epi64(dy, 32);
+        __m256i odd = _mm256_add_epi64(_mm256_mul_epi32(dx_odd, dx_odd), _mm256_mul_epi32(dy_odd, dy_odd));
+
+        unsigned far_even = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(even, r2))));
+        unsigned far_odd = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(odd, r2))));
+        unsigned hits = ~(spread_bits(far_even) | (spread_bits(far_odd) << 1)) & 0xFFu;
+        n = emit_hits(hits, i, out, n);
+    }
+    return select_tail(xs, ys, i, count, x, y, radius, out, n);
+}
+
+static RangeIsa detect_isa() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return RangeIsa::Avx2;
+    if (__builtin_cpu_supports("sse2")) return RangeIsa::Sse2;
+    return RangeIsa::Scalar;
+}
+
+#else
+
+static RangeIsa detect_isa() {
+    return RangeIsa::Scalar;
+}
+
+#endif
+
+RangeIsa range_isa() {
+    static const RangeIsa best = detect_isa();
+    return best;
+}
+
+const char *range_isa_name(RangeIsa isa) {
+    switch (isa) {
+        case RangeIsa::Scalar: return "scalar";
+        case RangeIsa::Sse2: return "sse2";
+        case RangeIsa::Avx2: return "avx2";
+    }
+    return "unknown";
+}
+
+size_t select_close(RangeIsa isa, const int *xs, const int *ys, size_t count,
+                    int x, int y, int radius, std::uint32_t *out) {
+    if (isa > range_isa()) isa = range_isa();
+
+    switch (isa) {
+#ifdef LAB07_X86_KERNELS
+        case RangeIsa::Avx2: return select_avx2(xs, ys, count, x, y, radius, out);
+        case RangeIsa::Sse2: return select_sse2(xs, ys, count, x, y, radius, out);
+#endif
+        default: return select_scalar(xs, ys, count, x, y, radius, out);
+    }
+}
+
+size_t select_close(const int *xs, const int *ys, size_t count,
+                    int x, int y, int radius, std::uint32_t *out) {
+    static const RangeIsa isa = range_isa();
+    return select_close(isa, xs, ys, count, x, y, radius, out);
+}
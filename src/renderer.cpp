@@ -0,0 +1,95 @@
+#include "renderer.h"
+#include <algorithm>
+#include <charconv>
+
+char npc_symbol(NpcType type) {
+    switch (type) {
+        case DruidType: return 'D';
+        case SquirrelType: return 'S';
+        case WerewolfType: return 'W';
+        default: return '.';
+    }
+}
+
+MapRenderer::MapRenderer(const Viewport &view)
+    : view(view),
+      previous(static_cast<size_t>(view.cols) * view.rows, '.'),
+      current(previous.size(), '.')
+{
+    frame.reserve(previous.size() * 2);
+}
+
+const Viewport &MapRenderer::viewport() const {
+    return view;
+}
+
+void MapRenderer::rasterize(const WorldSnapshot &snapshot) {
+    std::fill(current.begin(), current.end(), '.');
+
+    long long span_x = static_cast<long long>(view.cols) * view.zoom;
+    long long span_y = static_cast<long long>(view.rows) * view.zoom;
+
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        if (!snapshot.alive_flags[i]) continue;
+
+        long long dx = static_cast<long long>(snapshot.xs[i]) - view.x;
+        long long dy = static_cast<long long>(snapshot.ys[i]) - view.y;
+        if (dx < 0 || dy < 0 || dx >= span_x || dy >= span_y) continue;
+
+        current[(dy / view.zoom) * view.cols + dx / view.zoom] = npc_symbol(snapshot.types[i]);
+    }
+}
+
+void MapRenderer::move_cursor(int row, int col) {
+    char buffer[32] = "\x1b[";
+    char *p = std::to_chars(buffer + 2, buffer + 14, row).ptr;
+    *p++ = ';';
+    p = std::to_chars(p, buffer + 28, col).ptr;
+    *p++ = 'H';
+    frame.append(buffer, p);
+}
+
+const std::string &MapRenderer::render(const WorldSnapshot &snapshot) {
+    rasterize(snapshot);
+    frame.clear();
+
+    if (first_frame) {
+        frame += "\x1b[2J";
+    }
+
+    if (first_frame || snapshot.alive != previous_alive) {
+        move_cursor(1, 1);
+        frame += "Alive: ";
+        frame += std::to_string(snapshot.alive);
+        frame += "\x1b[K";
+        previous_alive = snapshot.alive;
+    }
+
+    // Row 1 is the status line; the map starts on row 2. Runs of changed
+    // cells share a single cursor move.
+    for (int r = 0; r < view.rows; ++r) {
+        const char *now = current.data() + static_cast<size_t>(r) * view.cols;
+        const char *before = previous.data() + static_cast<size_t>(r) * view.cols;
+
+        int c = 0;
+        while (c < view.cols) {
+            if (!first_frame && now[c] == before[c]) {
+                ++c;
+                continue;
+            }
+
+            move_cursor(r + 2, c + 1);
+            while (c < view.cols && (first_frame || now[c] != before[c])) {
+                frame += now[c++];
+            }
+        }
+    }
+
+    if (!frame.empty()) {
+        move_cursor(view.rows + 2, 1);
+    }
+
+    previous.swap(current);
+    first_frame = false;
+    return frame;
+}
\ No newline at end of file
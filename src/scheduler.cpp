@@ -0,0 +1,45 @@
+#include "scheduler.h"
+#include <algorithm>
+#include <thread>
+
+TickScheduler::TickScheduler(clock::duration step, std::uint64_t max_catch_up,
+                             clock::time_point origin)
+    : step(step), max_catch_up(std::max<std::uint64_t>(1, max_catch_up)), origin(origin) {}
+
+std::uint64_t TickScheduler::due(clock::time_point now) const {
+    if (step.count() <= 0) return 1;
+    if (now < origin) return 0;
+
+    std::uint64_t elapsed = static_cast<std::uint64_t>((now - origin) / step) + 1;
+    return elapsed > scheduled ? elapsed - scheduled : 0;
+}
+
+std::uint64_t TickScheduler::poll(clock::time_point now) {
+    std::uint64_t count = due(now);
+    if (count > max_catch_up) {
+        skipped_ticks += count - max_catch_up;
+        scheduled += count - max_catch_up;
+        count = max_catch_up;
+    }
+    scheduled += count;
+    return count;
+}
+
+std::uint64_t TickScheduler::wait(const std::atomic<bool> &running) {
+    while (running) {
+        auto now = clock::now();
+        std::uint64_t count = poll(now);
+        if (count > 0) return count;
+
+        std::this_thread::sleep_until(std::min(next_deadline(), now + WAIT_SLICE));
+    }
+    return 0;
+}
+
+TickScheduler::clock::time_point TickScheduler::next_deadline() const {
+    return origin + step * static_cast<clock::rep>(scheduled);
+}
+
+std::uint64_t TickScheduler::skipped() const {
+    return skipped_ticks;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include "snapshot.h"
+#include <atomic>
+
+SnapshotBuffer::SnapshotBuffer()
+    : front(std::make_shared<WorldSnapshot>()), back(std::make_shared<WorldSnapshot>()) {}
+
+WorldSnapshot &SnapshotBuffer::begin_write() {
+    if (back.use_count() > 1) {
+        back = std::make_shared<WorldSnapshot>();
+    }
+    return *back;
+}
+
+void SnapshotBuffer::publish() {
+    back = std::atomic_exchange(&front, back);
+}
+
+std::shared_ptr<const WorldSnapshot> SnapshotBuffer::acquire() const {
+    return std::atomic_load(&front);
+}
\ No newline at end of file
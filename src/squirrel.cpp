@@ -2,17 +2,17 @@
 #include "werewolf.h"
 #include "druid.h"
 
-Squirrel::Squirrel(int x, int y, const std::string& name) 
-    : NPC(SquirrelType, x, y, name) {}
+Squirrel::Squirrel(int x, int y, std::string_view name, int limit, NameTable &names)
+    : NPC(SquirrelType, x, y, name, limit, names) {}
 
-Squirrel::Squirrel(std::istream &is) : NPC(SquirrelType, is) {}
+Squirrel::Squirrel(std::istream &is, int limit) : NPC(SquirrelType, is, limit) {}
 
 void Squirrel::print() {
     std::cout << *this;
 }
 
 void Squirrel::save(std::ostream &os) {
-    os << SquirrelType << std::endl;
+    os << SquirrelType << '\n';
     NPC::save(os);
 }
 
@@ -20,21 +20,6 @@ bool Squirrel::accept(std::shared_ptr<NPCVisitor> visitor) {
     return visitor->visit(std::static_pointer_cast<Squirrel>(shared_from_this()));
 }
 
-bool Squirrel::fight(std::shared_ptr<Squirrel> other) {
-    fight_notify(other, false);
-    return false;
-}
-
-bool Squirrel::fight(std::shared_ptr<Werewolf> other) {
-    fight_notify(other, true);
-    return true;
-}
-
-bool Squirrel::fight(std::shared_ptr<Druid> other) {
-    fight_notify(other, false);
-    return false;
-}
-
 int Squirrel::get_move_distance() const {
     return 0;
 }
@@ -0,0 +1,78 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) threads = 1;
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    start_cv.notify_all();
+
+    for (auto &worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers.size() + 1;
+}
+
+void ThreadPool::run_tasks(const std::function<void(size_t)> &fn, size_t count) {
+    for (size_t task = next_task.fetch_add(1); task < count; task = next_task.fetch_add(1)) {
+        fn(task);
+    }
+}
+
+void ThreadPool::worker_loop() {
+    size_t seen = 0;
+    while (true) {
+        const std::function<void(size_t)> *fn;
+        size_t count;
+        {
+            std::unique_lock lock(mutex);
+            start_cv.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            fn = job;
+            count = job_count;
+        }
+
+        run_tasks(*fn, count);
+
+        {
+            std::lock_guard lock(mutex);
+            if (--busy == 0) done_cv.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)> &fn) {
+    if (count == 0) return;
+
+    if (workers.empty() || count == 1) {
+        for (size_t task = 0; task < count; ++task) fn(task);
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        job = &fn;
+        job_count = count;
+        next_task = 0;
+        busy = workers.size();
+        ++generation;
+    }
+    start_cv.notify_all();
+
+    run_tasks(fn, count);
+
+    std::unique_lock lock(mutex);
+    done_cv.wait(lock, [this]() { return busy == 0; });
+    job = nullptr;
+}
\ No newline at end of file
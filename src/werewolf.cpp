@@ -2,17 +2,17 @@
 #include "squirrel.h"
 #include "druid.h"
 
-Werewolf::Werewolf(int x, int y, const std::string& name) 
-    : NPC(WerewolfType, x, y, name) {}
+Werewolf::Werewolf(int x, int y, std::string_view name, int limit, NameTable &names)
+    : NPC(WerewolfType, x, y, name, limit, names) {}
 
-Werewolf::Werewolf(std::istream &is) : NPC(WerewolfType, is) {}
+Werewolf::Werewolf(std::istream &is, int limit) : NPC(WerewolfType, is, limit) {}
 
 void Werewolf::print() {
     std::cout << *this;
 }
 
 void Werewolf::save(std::ostream &os) {
-    os << WerewolfType << std::endl;
+    os << WerewolfType << '\n';
     NPC::save(os);
 }
 
@@ -20,21 +20,6 @@ bool Werewolf::accept(std::shared_ptr<NPCVisitor> visitor) {
     return visitor->visit(std::static_pointer_cast<Werewolf>(shared_from_this()));
 }
 
-bool Werewolf::fight(std::shared_ptr<Squirrel> other) {
-    fight_notify(other, false);
-    return false;
-}
-
-bool Werewolf::fight(std::shared_ptr<Werewolf> other) {
-    fight_notify(other, false);
-    return false;
-}
-
-bool Werewolf::fight(std::shared_ptr<Druid> other) {
-    fight_notify(other, true);
-    return true;
-}
-
 int Werewolf::get_move_distance() const {
     return 0;
 }
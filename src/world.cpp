@@ -0,0 +1,110 @@
+#include "world.h"
+
+World::index_t World::add(const std::shared_ptr<NPC> &npc) {
+    index_t index = static_cast<index_t>(xs.size());
+
+    xs.push_back(npc->get_x());
+    ys.push_back(npc->get_y());
+    types.push_back(npc->get_type());
+    alive_flags.push_back(npc->is_alive() ? 1 : 0);
+    if (npc->is_alive()) {
+        alive_total++;
+        alive_by_type[npc->get_type()]++;
+    }
+    move_distances.push_back(npc->get_move_distance());
+    kill_distances.push_back(npc->get_kill_distance());
+    ids.push_back(next_id++);
+    name_ids.push_back(npc->get_name_id());
+    handles.push_back(npc);
+
+    return index;
+}
+
+void World::reserve(size_t count) {
+    xs.reserve(count);
+    ys.reserve(count);
+    types.reserve(count);
+    alive_flags.reserve(count);
+    move_distances.reserve(count);
+    kill_distances.reserve(count);
+    ids.reserve(count);
+    name_ids.reserve(count);
+    handles.reserve(count);
+}
+
+void World::clear() {
+    xs.clear();
+    ys.clear();
+    types.clear();
+    alive_flags.clear();
+    move_distances.clear();
+    kill_distances.clear();
+    ids.clear();
+    name_ids.clear();
+    handles.clear();
+    next_id = 0;
+}
+
+void World::set_position(index_t i, int x, int y) {
+    xs[i] = x;
+    ys[i] = y;
+    handles[i]->set_position(x, y);
+}
+
+void World::kill(index_t i) {
+    if (!alive_flags[i]) return;
+
+    alive_flags[i] = 0;
+    alive_total.fetch_sub(1, std::memory_order_relaxed);
+    alive_by_type[types[i]].fetch_sub(1, std::memory_order_relaxed);
+    handles[i]->make_dead();
+}
+
+size_t World::compact(std::vector<index_t> &remap) {
+    remap.assign(size(), INVALID_INDEX);
+
+    index_t out = 0;
+    for (index_t i = 0; i < size(); ++i) {
+        if (!alive_flags[i]) continue;
+
+        remap[i] = out;
+        if (out != i) {
+            xs[out] = xs[i];
+            ys[out] = ys[i];
+            types[out] = types[i];
+            alive_flags[out] = alive_flags[i];
+            move_distances[out] = move_distances[i];
+            kill_distances[out] = kill_distances[i];
+            ids[out] = ids[i];
+            name_ids[out] = name_ids[i];
+            handles[out] = std::move(handles[i]);
+        }
+        ++out;
+    }
+
+    size_t removed = size() - out;
+    xs.resize(out);
+    ys.resize(out);
+    types.resize(out);
+    alive_flags.resize(out);
+    move_distances.resize(out);
+    kill_distances.resize(out);
+    ids.resize(out);
+    name_ids.resize(out);
+    handles.resize(out);
+    return removed;
+}
+
+void World::capture(WorldSnapshot &out, std::uint64_t epoch) const {
+    out.epoch = epoch;
+    out.xs = xs;
+    out.ys = ys;
+    out.types = types;
+    out.alive_flags = alive_flags;
+    out.name_ids = name_ids;
+
+    out.alive = alive();
+    for (int t = 0; t < NPC_TYPE_COUNT; ++t) {
+        out.alive_by_type[t] = alive(static_cast<NpcType>(t));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "world_file.h"
+#include "factory.h"
+#include <fstream>
+#include <cstring>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+
+WorldFile::WorldFile(const std::string &filename) : file(filename), data(file.data()) {
+    size_t length = file.size();
+    if (length < sizeof(WorldFileHeader)) {
+        throw std::runtime_error("Invalid world file: " + filename);
+    }
+
+    const auto &h = header();
+    bool valid = std::memcmp(h.magic, WORLD_FILE_MAGIC, sizeof(h.magic)) == 0 &&
+                 h.version == WORLD_FILE_VERSION &&
+                 h.count <= (length - sizeof(WorldFileHeader)) / sizeof(NpcRecord) &&
+                 h.names_offset == sizeof(WorldFileHeader) + h.count * sizeof(NpcRecord) &&
+                 h.names_count <= (length - h.names_offset) / sizeof(NameEntry) &&
+                 h.strings_offset == h.names_offset + h.names_count * sizeof(NameEntry) &&
+                 h.strings_size <= length - h.strings_offset;
+
+    for (size_t n = 0; valid && n < h.names_count; ++n) {
+        const auto &e = reinterpret_cast<const NameEntry *>(data + h.names_offset)[n];
+        valid = static_cast<std::uint64_t>(e.offset) + e.length <= h.strings_size;
+    }
+
+    for (size_t i = 0; valid && i < h.count; ++i) {
+        valid = record(i).name < h.names_count;
+    }
+
+    if (!valid) {
+        throw std::runtime_error("Invalid world file: " + filename);
+    }
+}
+
+const WorldFileHeader &WorldFile::header() const {
+    return *reinterpret_cast<const WorldFileHeader *>(data);
+}
+
+size_t WorldFile::size() const {
+    return static_cast<size_t>(header().count);
+}
+
+const NpcRecord &WorldFile::record(size_t i) const {
+    return reinterpret_cast<const NpcRecord *>(data + sizeof(WorldFileHeader))[i];
+}
+
+size_t WorldFile::names_count() const {
+    return static_cast<size_t>(header().names_count);
+}
+
+std::string_view WorldFile::table_name(size_t n) const {
+    const auto &e = reinterpret_cast<const NameEntry *>(data + header().names_offset)[n];
+    return std::string_view(data + header().strings_offset + e.offset, e.length);
+}
+
+std::string_view WorldFile::name(size_t i) const {
+    return table_name(record(i).name);
+}
+
+std::shared_ptr<NPC> WorldFile::make_npc(size_t i, int limit,
+                                         const std::shared_ptr<NpcArena> &arena) const {
+    const auto &r = record(i);
+    return factory(static_cast<NpcType>(r.type), r.x, r.y, name(i), limit, arena);
+}
+
+bool WorldFile::is_world_file(const std::string &filename) {
+    std::ifstream is(filename, std::ios::binary);
+    char magic[sizeof(WORLD_FILE_MAGIC)] = {};
+    is.read(magic, sizeof(magic));
+    return is.gcount() == sizeof(magic) &&
+           std::memcmp(magic, WORLD_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+void save_binary(const set_t &array, const std::string &filename) {
+    std::vector<NpcRecord> records;
+    std::vector<NameEntry> entries;
+    // Keyed by text: ids are only unique within one NameTable, and a set may
+    // mix NPCs from several games.
+    std::unordered_map<std::string_view, std::uint32_t> table;
+    std::string strings;
+    records.reserve(array.size());
+
+    for (const auto &n : array) {
+        std::string_view name = n->get_name();
+        auto [it, added] = table.emplace(name, static_cast<std::uint32_t>(entries.size()));
+        if (added) {
+            entries.push_back({static_cast<std::uint32_t>(strings.size()),
+                               static_cast<std::uint32_t>(name.size())});
+            strings += name;
+        }
+
+        records.push_back({
+            n->get_x(),
+            n->get_y(),
+            static_cast<std::uint32_t>(n->get_type()),
+            it->second
+        });
+    }
+
+    WorldFileHeader header{};
+    std::memcpy(header.magic, WORLD_FILE_MAGIC, sizeof(header.magic));
+    header.version = WORLD_FILE_VERSION;
+    header.count = records.size();
+    header.names_count = entries.size();
+    header.names_offset = sizeof(WorldFileHeader) + records.size() * sizeof(NpcRecord);
+    header.strings_offset = header.names_offset + entries.size() * sizeof(NameEntry);
+    header.strings_size = strings.size();
+
+    std::ofstream fs(filename, std::ios::binary);
+    fs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    fs.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(NpcRecord));
+    fs.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(NameEntry));
+    fs.write(strings.data(), strings.size());
+}
+
+set_t load_binary(const std::string &filename, int limit) {
+    set_t result;
+    try {
+        WorldFile file(filename);
+        auto arena = std::make_shared<NpcArena>(npc_arena_bytes(file.size()));
+        for (size_t i = 0; i < file.size(); ++i) {
+            auto npc = file.make_npc(i, limit, arena);
+            if (npc) result.insert(npc);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return result;
+}
\ No newline at end of file
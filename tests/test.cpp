@@ -5,32 +5,62 @@
 #include "druid.h"
 #include "visitor.h"
 #include "factory.h"
+#include "grid.h"
+#include "world.h"
+#include "renderer.h"
+#include "game.h"
+#include "combat.h"
+#include "ring_buffer.h"
+#include "fight_queue.h"
+#include "thread_pool.h"
+#include "random.h"
+#include "config.h"
+#include "world_file.h"
+#include "npc_stream.h"
+#include "log_sink.h"
+#include "journal.h"
+#include "event_bus.h"
+#include "scheduler.h"
+#include "batch.h"
+#include "range_query.h"
 #include <sstream>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include <cstdio>
 
 class MockObserver : public IFightObserver {
 public:
     bool fight_observed = false;
-    std::shared_ptr<NPC> last_attacker;
-    std::shared_ptr<NPC> last_defender;
+    const NPC *last_attacker = nullptr;
+    const NPC *last_defender = nullptr;
     bool last_win = false;
+    size_t notices = 0;
 
-    void on_fight(const std::shared_ptr<NPC> attacker, 
-                 const std::shared_ptr<NPC> defender, 
-                 bool win) override {
+    void on_fights(const FightNotice *batch, size_t count) override {
         fight_observed = true;
-        last_attacker = attacker;
-        last_defender = defender;
-        last_win = win;
+        last_attacker = batch[count - 1].attacker;
+        last_defender = batch[count - 1].defender;
+        last_win = batch[count - 1].win;
+        notices += count;
     }
 };
 
 class NPCTest : public ::testing::Test {
 protected:
     void SetUp() override {
+        set_kill_logging(false);
         observer = std::make_shared<MockObserver>();
+        subscription = EventBus::global().subscribe(EventKind::Fight, observer);
+    }
+    void TearDown() override {
+        EventBus::global().unsubscribe(subscription);
     }
     std::shared_ptr<MockObserver> observer;
+    EventBus::subscription_t subscription;
 };
 
 TEST_F(NPCTest, NPCCreation) {
@@ -88,8 +118,6 @@ TEST_F(NPCTest, VisitorPatternCorrectness) {
     auto squirrel = std::make_shared<Squirrel>(100, 100, "Squirrel1");
     auto werewolf = std::make_shared<Werewolf>(100, 100, "Werewolf1");
     
-    squirrel->subscribe(observer);
-    
     auto visitor = std::make_shared<FightVisitor>(squirrel);
     bool result = werewolf->accept(visitor);
     
@@ -103,8 +131,6 @@ TEST_F(NPCTest, SquirrelFightLogic) {
     auto werewolf = std::make_shared<Werewolf>(100, 100, "Werewolf1");
     auto druid = std::make_shared<Druid>(100, 100, "Druid1");
 
-    squirrel->subscribe(observer);
-
     auto visitor1 = std::make_shared<FightVisitor>(squirrel);
     EXPECT_TRUE(werewolf->accept(visitor1));
     EXPECT_TRUE(observer->fight_observed);
@@ -123,8 +149,6 @@ TEST_F(NPCTest, WerewolfFightLogic) {
     auto druid = std::make_shared<Druid>(100, 100, "Druid1");
     auto squirrel = std::make_shared<Squirrel>(100, 100, "Squirrel1");
 
-    werewolf->subscribe(observer);
-
     auto visitor1 = std::make_shared<FightVisitor>(werewolf);
     EXPECT_TRUE(druid->accept(visitor1));
     EXPECT_TRUE(observer->fight_observed);
@@ -141,8 +165,6 @@ TEST_F(NPCTest, DruidFightLogic) {
     auto squirrel = std::make_shared<Squirrel>(100, 100, "Squirrel1");
     auto werewolf = std::make_shared<Werewolf>(100, 100, "Werewolf1");
 
-    druid->subscribe(observer);
-    
     auto visitor1 = std::make_shared<FightVisitor>(druid);
     EXPECT_FALSE(squirrel->accept(visitor1));
     EXPECT_TRUE(observer->fight_observed);
@@ -199,6 +221,914 @@ TEST_F(NPCTest, FactoryFunction) {
     EXPECT_EQ(druid->get_type(), DruidType);
 }
 
+TEST_F(NPCTest, SpatialGridNeighbors) {
+    SpatialGrid grid(100, 10);
+    grid.insert(0, 15, 15);
+    grid.insert(1, 22, 18);
+    grid.insert(2, 80, 80);
+
+    std::vector<World::index_t> found;
+    grid.for_each_near(15, 15, 10, [&](World::index_t index) {
+        found.push_back(index);
+    });
+    EXPECT_EQ(found.size(), 2u);
+
+    grid.move(0, 75, 75);
+
+    found.clear();
+    grid.for_each_near(75, 75, 10, [&](World::index_t index) {
+        found.push_back(index);
+    });
+    EXPECT_EQ(found.size(), 2u);
+}
+
+TEST_F(NPCTest, RangeKernelsMatchScalar) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> near(-60, 60);
+    std::uniform_int_distribution<int> far(-1000000000, 1000000000);
+
+    for (size_t count : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 31u, 64u, 257u}) {
+        std::vector<int> xs(count), ys(count);
+        for (size_t i = 0; i < count; ++i) {
+            bool wide = i % 5 == 4;
+            xs[i] = wide ? far(gen) : 500 + near(gen);
+            ys[i] = wide ? far(gen) : 500 + near(gen);
+        }
+        if (count > 2) {
+            xs[1] = 530; ys[1] = 540;   // exactly on the radius
+            xs[2] = 530; ys[2] = 541;   // one step outside
+        }
+
+        std::vector<std::uint32_t> expected;
+        for (size_t i = 0; i < count; ++i) {
+            if (within(xs[i], ys[i], 500, 500, 50)) expected.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        for (RangeIsa isa : {RangeIsa::Scalar, RangeIsa::Sse2, RangeIsa::Avx2}) {
+            std::vector<std::uint32_t> hits(count);
+            size_t n = select_close(isa, xs.data(), ys.data(), count, 500, 500, 50, hits.data());
+            hits.resize(n);
+            EXPECT_EQ(hits, expected) << range_isa_name(isa) << " count " << count;
+        }
+    }
+}
+
+TEST_F(NPCTest, PackedGridQueryMatchesNearScan) {
+    World world;
+    SpatialGrid grid(200, 20);
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> coord(0, 199);
+    for (int i = 0; i < 300; ++i) {
+        auto npc = std::make_shared<Squirrel>(coord(gen), coord(gen), "Packed", 199);
+        grid.insert(world.add(npc), npc->get_x(), npc->get_y());
+    }
+
+    std::vector<std::uint32_t> hits;
+    for (World::index_t q = 0; q < world.size(); q += 7) {
+        std::vector<World::index_t> expected, found;
+        grid.for_each_near(world.x(q), world.y(q), 20, [&](World::index_t other) {
+            if (world.is_close(q, other, 20)) expected.push_back(other);
+        });
+        grid.for_each_close(world.x(q), world.y(q), 20, hits, [&](World::index_t other) {
+            found.push_back(other);
+        });
+        EXPECT_EQ(found, expected);
+    }
+}
+
+TEST_F(NPCTest, SparseTilesSleepWithoutMovers) {
+    const int far = 2000000010;
+    SpatialGrid grid(far + 1, 64);
+    grid.insert(0, 10, 10);
+    grid.insert(1, far, far);
+    grid.insert(2, far - 5, far, true);
+    grid.insert(3, 1000000, 1000000);
+
+    EXPECT_EQ(grid.tile_count(), 3u);
+    ASSERT_EQ(grid.awake_tiles().size(), 1u);
+    EXPECT_EQ(grid.tile(grid.awake_tiles()[0]).members.size(), 2u);
+
+    std::vector<World::index_t> found;
+    grid.for_each_near(far, far, 10, [&](World::index_t i) { found.push_back(i); });
+    EXPECT_EQ(found.size(), 2u);
+
+    grid.move(2, 500, 500);
+    EXPECT_EQ(grid.tile_count(), 4u);
+    ASSERT_EQ(grid.awake_tiles().size(), 1u);
+    EXPECT_EQ(grid.tile(grid.awake_tiles()[0]).tx, 500 / 64);
+
+    grid.move(3, 10, 12);
+    EXPECT_EQ(grid.tile_count(), 3u);
+
+    std::vector<World::index_t> remap = {0, World::INVALID_INDEX, 1, 2};
+    grid.remap(remap);
+    EXPECT_EQ(grid.tile_count(), 2u);
+    EXPECT_EQ(grid.awake_tiles().size(), 1u);
+
+    found.clear();
+    grid.for_each_near(10, 10, 5, [&](World::index_t i) { found.push_back(i); });
+    EXPECT_EQ(found, (std::vector<World::index_t>{0, 2}));
+
+    grid.deactivate(1);
+    EXPECT_TRUE(grid.awake_tiles().empty());
+    EXPECT_EQ(grid.tile_count(), 2u);
+    grid.deactivate(1);
+    grid.move(1, 12, 12);
+    EXPECT_TRUE(grid.awake_tiles().empty());
+    EXPECT_EQ(grid.tile_count(), 1u);
+}
+
+TEST_F(NPCTest, WorldFacade) {
+    World world;
+    auto druid = std::make_shared<Druid>(10, 20, "Druid1");
+    auto squirrel = std::make_shared<Squirrel>(13, 24, "Squirrel1");
+
+    auto d = world.add(druid);
+    auto s = world.add(squirrel);
+
+    EXPECT_EQ(world.size(), 2u);
+    EXPECT_EQ(world.type(d), DruidType);
+    EXPECT_EQ(world.kill_distance(d), 10);
+    EXPECT_TRUE(world.is_close(d, s, 5));
+    EXPECT_FALSE(world.is_close(d, s, 4));
+
+    world.set_position(d, 40, 50);
+    world.kill(s);
+
+    EXPECT_EQ(druid->get_x(), 40);
+    EXPECT_EQ(druid->get_y(), 50);
+    EXPECT_FALSE(world.is_alive(s));
+    EXPECT_FALSE(squirrel->is_alive());
+}
+
+TEST_F(NPCTest, SweepFightMatchesBruteForce) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> coord(0, 200);
+    std::uniform_int_distribution<> type(1, 3);
+
+    set_t array;
+    for (int i = 0; i < 300; ++i) {
+        int x = coord(gen);
+        int y = coord(gen);
+        switch (type(gen)) {
+            case SquirrelType: array.insert(std::make_shared<Squirrel>(x, y, "S")); break;
+            case WerewolfType: array.insert(std::make_shared<Werewolf>(x, y, "W")); break;
+            default: array.insert(std::make_shared<Druid>(x, y, "D")); break;
+        }
+    }
+
+    for (size_t distance : {0u, 5u, 20u, 60u}) {
+        set_t expected;
+        for (const auto &attacker : array) {
+            for (const auto &defender : array) {
+                if (attacker != defender && attacker->is_close(defender, distance) &&
+                    !expected.count(defender) &&
+                    defender->accept(std::make_shared<FightVisitor>(attacker))) {
+                    expected.insert(defender);
+                }
+            }
+        }
+        EXPECT_EQ(fight(array, distance), expected);
+    }
+}
+
+TEST_F(NPCTest, CombatTableMatchesVisitor) {
+    static_assert(can_kill(SquirrelType, WerewolfType), "squirrel kills werewolf");
+    static_assert(can_kill(WerewolfType, DruidType), "werewolf kills druid");
+    static_assert(!can_kill(DruidType, SquirrelType), "druid kills nobody");
+
+    std::vector<std::shared_ptr<NPC>> npcs = {
+        std::make_shared<Squirrel>(0, 0, "S"),
+        std::make_shared<Werewolf>(0, 0, "W"),
+        std::make_shared<Druid>(0, 0, "D")
+    };
+
+    for (const auto &attacker : npcs) {
+        for (const auto &defender : npcs) {
+            bool visited = defender->accept(std::make_shared<FightVisitor>(attacker));
+            EXPECT_EQ(visited, can_kill(attacker->get_type(), defender->get_type()));
+        }
+    }
+}
+
+TEST_F(NPCTest, RingBufferBatches) {
+    RingBuffer<int> ring(8);
+    EXPECT_EQ(ring.capacity(), 8u);
+
+    std::vector<int> items = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(ring.push_batch(items.data(), items.size()), 8u);
+    EXPECT_FALSE(ring.push(11));
+    EXPECT_EQ(ring.size(), 8u);
+
+    std::vector<int> out(16);
+    EXPECT_EQ(ring.pop_batch(out.data(), 3), 3u);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[2], 3);
+    EXPECT_EQ(ring.pop_batch(out.data(), out.size()), 5u);
+    EXPECT_EQ(out[4], 8);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(NPCTest, RingBufferConcurrentProducers) {
+    RingBuffer<int> ring(64);
+    const int per_producer = 2000;
+    std::vector<std::thread> producers;
+
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&ring, p]() {
+            std::vector<int> batch;
+            for (int i = 0; i < per_producer; ++i) {
+                batch.push_back(p * per_producer + i);
+                if (batch.size() == 16 || i == per_producer - 1) {
+                    size_t done = 0;
+                    while (done < batch.size()) {
+                        size_t pushed = ring.push_batch(batch.data() + done, batch.size() - done);
+                        if (pushed == 0) std::this_thread::yield();
+                        done += pushed;
+                    }
+                    batch.clear();
+                }
+            }
+        });
+    }
+
+    std::vector<int> seen(4 * per_producer, 0);
+    std::vector<int> out(32);
+    int received = 0;
+    while (received < 4 * per_producer) {
+        size_t n = ring.pop_batch(out.data(), out.size());
+        if (n == 0) std::this_thread::yield();
+        for (size_t i = 0; i < n; ++i) seen[out[i]]++;
+        received += static_cast<int>(n);
+    }
+
+    for (auto &t : producers) t.join();
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](int c) { return c == 1; }));
+}
+
+TEST_F(NPCTest, FightQueueOverflowPolicies) {
+    std::atomic<bool> running{true};
+    std::vector<Fight> fights;
+    for (World::index_t i = 0; i < 12; ++i) {
+        fights.push_back({i, i + 1, 0});
+    }
+
+    FightQueue drop_oldest(8, QueuePolicy::DropOldest);
+    EXPECT_EQ(drop_oldest.publish(fights, running), 8u);
+    EXPECT_EQ(drop_oldest.size(), 8u);
+    EXPECT_EQ(drop_oldest.stats().dropped, 4u);
+
+    Fight out[8];
+    drop_oldest.drain(out, 8);
+    EXPECT_EQ(out[0].attacker, 4u);
+
+    FightQueue drop_newest(8, QueuePolicy::DropNewest);
+    EXPECT_EQ(drop_newest.publish(fights, running), 8u);
+    EXPECT_EQ(drop_newest.stats().enqueued, 8u);
+    EXPECT_EQ(drop_newest.stats().dropped, 4u);
+
+    drop_newest.drain(out, 8);
+    EXPECT_EQ(out[0].attacker, 0u);
+    EXPECT_EQ(out[7].attacker, 7u);
+}
+
+TEST_F(NPCTest, ThreadPoolRunsEveryTaskOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(100);
+
+    for (int round = 0; round < 10; ++round) {
+        pool.run(hits.size(), [&](size_t task) { hits[task]++; });
+    }
+
+    for (auto &h : hits) {
+        EXPECT_EQ(h.load(), 10);
+    }
+}
+
+TEST_F(NPCTest, SameSeedGamesProduceIdenticalJournals) {
+    auto run = [](const std::string &path) {
+        GameConfig config;
+        config.map_size = 100;
+        config.npc_count = 400;
+        config.headless = true;
+        config.seed = 77;
+        config.threads = 4;
+        config.journal_path = path;
+
+        Game game(config);
+        for (int i = 0; i < 10; ++i) game.step();
+        return game.collect_metrics().fights_resolved;
+    };
+
+    EXPECT_EQ(run("test_seed_a.journal"), run("test_seed_b.journal"));
+
+    std::ifstream a("test_seed_a.journal", std::ios::binary);
+    std::ifstream b("test_seed_b.journal", std::ios::binary);
+    std::string bytes_a((std::istreambuf_iterator<char>(a)), std::istreambuf_iterator<char>());
+    std::string bytes_b((std::istreambuf_iterator<char>(b)), std::istreambuf_iterator<char>());
+    EXPECT_GT(bytes_a.size(), sizeof(JournalHeader) + 100 * sizeof(FightEvent));
+    EXPECT_EQ(bytes_a, bytes_b);
+
+    std::remove("test_seed_a.journal");
+    std::remove("test_seed_b.journal");
+}
+
+TEST_F(NPCTest, ShardedTickSurvivesQueueOverflow) {
+    GameConfig config;
+    config.map_size = 100;
+    config.npc_count = 1500;
+    config.game_time = 1;
+    config.tick_ms = 1;
+    config.headless = true;
+    config.seed = 21;
+    config.threads = 4;
+    config.queue_capacity = 4;
+
+    Game game(config);
+    testing::internal::CaptureStdout();
+    game.run();
+    EXPECT_NE(testing::internal::GetCapturedStdout().find("Survivors:"), std::string::npos);
+
+    auto m = game.collect_metrics();
+    EXPECT_GE(m.ticks, 2u);
+    EXPECT_GT(m.enqueued, m.ticks * config.queue_capacity);
+    EXPECT_LE(m.queue_depth_max, config.queue_capacity);
+    EXPECT_EQ(m.dropped, 0u);
+}
+
+TEST_F(NPCTest, CounterRngIsReproducible) {
+    RandomStream a(12345, RngPurpose::Fight, 7, 1, 2);
+    RandomStream b(12345, RngPurpose::Fight, 7, 1, 2);
+    RandomStream other_tick(12345, RngPurpose::Fight, 8, 1, 2);
+
+    bool differs = false;
+    for (int i = 0; i < 100; ++i) {
+        std::uint32_t value = a.next();
+        EXPECT_EQ(value, b.next());
+        differs = differs || value != other_tick.next();
+    }
+    EXPECT_TRUE(differs);
+
+    RandomStream dice(1, RngPurpose::Move, 0, 0);
+    std::vector<int> counts(6, 0);
+    for (int i = 0; i < 6000; ++i) {
+        int roll = dice.uniform(1, 6);
+        ASSERT_GE(roll, 1);
+        ASSERT_LE(roll, 6);
+        counts[roll - 1]++;
+    }
+    for (int c : counts) {
+        EXPECT_GT(c, 800);
+    }
+
+    EXPECT_EQ(generate_name(99, 5), generate_name(99, 5));
+}
+
+TEST_F(NPCTest, ConfigParsing) {
+    const char *args[] = {"lab07", "--map-size", "100000", "--npcs", "1000000",
+                          "--time", "5", "--tick-ms", "1", "--seed", "7",
+                          "--headless", "--queue-policy", "drop-oldest"};
+    GameConfig config = parse_args(14, const_cast<char **>(args));
+
+    EXPECT_EQ(config.map_size, 100000);
+    EXPECT_EQ(config.npc_count, 1000000);
+    EXPECT_EQ(config.game_time, 5);
+    EXPECT_EQ(config.tick_ms, 1);
+    EXPECT_EQ(config.seed, 7u);
+    EXPECT_TRUE(config.headless);
+    EXPECT_EQ(config.queue_policy, QueuePolicy::DropOldest);
+    EXPECT_EQ(config.turbo_ticks, 0u);
+
+    const char *turbo[] = {"lab07", "--turbo", "1000"};
+    EXPECT_EQ(parse_args(3, const_cast<char **>(turbo)).turbo_ticks, 1000u);
+
+    const char *bad[] = {"lab07", "--npcs", "-3"};
+    EXPECT_THROW(parse_args(3, const_cast<char **>(bad)), std::invalid_argument);
+
+    for (const char *flag : {"--time", "--tick-ms", "--zoom", "--threads"}) {
+        const char *too_big[] = {"lab07", flag, "4294967296"};
+        EXPECT_THROW(parse_args(3, const_cast<char **>(too_big)), std::invalid_argument) << flag;
+    }
+    const char *unpaced[] = {"lab07", "--tick-ms", "0"};
+    EXPECT_THROW(parse_args(3, const_cast<char **>(unpaced)), std::invalid_argument);
+
+    for (const char *seed : {"abc", "12x", "-1", "", "99999999999999999999"}) {
+        const char *bad_seed[] = {"lab07", "--seed", seed};
+        EXPECT_THROW(parse_args(3, const_cast<char **>(bad_seed)), std::invalid_argument) << seed;
+    }
+    const char *max_seed[] = {"lab07", "--seed", "18446744073709551615"};
+    EXPECT_EQ(parse_args(3, const_cast<char **>(max_seed)).seed, UINT64_MAX);
+}
+
+TEST_F(NPCTest, CoordinateLimitIsConfigurable) {
+    EXPECT_NO_THROW(std::make_shared<Druid>(90000, 90000, "FarDruid", 99999));
+    EXPECT_THROW(std::make_shared<Druid>(100, 100, "Druid", 99), std::runtime_error);
+    EXPECT_NE(factory(SquirrelType, 5000, 5000, "FarSquirrel", 9999), nullptr);
+
+    std::istringstream far_text("1 70000 80000 FarStream");
+    auto streamed = factory(far_text, 100000);
+    ASSERT_NE(streamed, nullptr);
+    EXPECT_EQ(streamed->get_y(), 80000);
+
+    set_t far_world = {factory(WerewolfType, 2000000000, 7, "FarText", NPC::MAX_COORDINATE_LIMIT)};
+    save(far_world, "test_far_world.txt");
+    auto loaded = load("test_far_world.txt");
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ((*loaded.begin())->get_x(), 2000000000);
+    std::remove("test_far_world.txt");
+}
+
+TEST_F(NPCTest, ArenaReserveFitsWholePopulation) {
+    auto single = std::make_shared<NpcArena>();
+    auto druid = factory(DruidType, 1, 1, "Sized", 500, single);
+    EXPECT_EQ(single->bytes_allocated(), arena_footprint<Druid>(1, 1, "Sized", 500));
+    EXPECT_GE(npc_arena_bytes(1), single->bytes_allocated());
+
+    const size_t count = 3000;
+    auto arena = std::make_shared<NpcArena>(npc_arena_bytes(count));
+    std::vector<std::shared_ptr<NPC>> npcs;
+    for (size_t i = 0; i < count; ++i) {
+        npcs.push_back(factory(static_cast<NpcType>(1 + i % 3), 0, 0, "Sized", 500, arena));
+    }
+    EXPECT_EQ(arena->block_count(), 1u);
+}
+
+TEST_F(NPCTest, FactoryAllocatesFromArena) {
+    auto arena = std::make_shared<NpcArena>();
+    std::vector<std::shared_ptr<NPC>> npcs;
+    for (int i = 0; i < 1000; ++i) {
+        npcs.push_back(factory(static_cast<NpcType>(1 + i % 3), i % 500, i % 500, "Pooled", 500, arena));
+        ASSERT_NE(npcs.back(), nullptr);
+    }
+
+    EXPECT_EQ(arena->block_count(), 1u);
+    EXPECT_GE(arena->bytes_allocated(), 1000 * sizeof(Squirrel));
+    EXPECT_EQ(npcs[3]->get_type(), SquirrelType);
+    EXPECT_EQ(npcs[4]->get_type(), WerewolfType);
+
+    std::weak_ptr<NpcArena> watch = arena;
+    arena.reset();
+    EXPECT_FALSE(watch.expired());
+    npcs.clear();
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST_F(NPCTest, NamesAreInterned) {
+    auto first = std::make_shared<Squirrel>(1, 1, "SharedName");
+    auto second = std::make_shared<Druid>(2, 2, std::string("Shared") + "Name");
+
+    EXPECT_EQ(first->get_name_id(), second->get_name_id());
+    EXPECT_EQ(first->get_name().data(), second->get_name().data());
+    EXPECT_EQ(NameTable::global().get(first->get_name_id()), "SharedName");
+    EXPECT_EQ(generate_name(7, 3).data(), generate_name(7, 3).data());
+}
+
+TEST_F(NPCTest, BinaryWorldFileRoundTrip) {
+    set_t array;
+    array.insert(factory(SquirrelType, 10, 20, "BinarySquirrel"));
+    array.insert(factory(WerewolfType, 30, 40, "BinaryWerewolf"));
+    array.insert(factory(DruidType, 50, 60, "BinaryDruid"));
+
+    const std::string filename = "test_world.bin";
+    set_t with_duplicate = array;
+    with_duplicate.insert(factory(DruidType, 70, 80, "BinaryDruid"));
+    save_binary(with_duplicate, filename);
+    {
+        WorldFile file(filename);
+        EXPECT_EQ(file.size(), 4u);
+        EXPECT_EQ(file.names_count(), 3u);
+    }
+
+    save_binary(array, filename);
+    EXPECT_TRUE(WorldFile::is_world_file(filename));
+
+    {
+        WorldFile file(filename);
+        ASSERT_EQ(file.size(), 3u);
+        std::set<std::string> names;
+        for (size_t i = 0; i < file.size(); ++i) {
+            names.insert(std::string(file.name(i)));
+        }
+        EXPECT_TRUE(names.count("BinaryDruid"));
+    }
+
+    set_t loaded = load(filename);
+    ASSERT_EQ(loaded.size(), 3u);
+    for (const auto &npc : loaded) {
+        auto original = std::find_if(array.begin(), array.end(), [&](const auto &n) {
+            return n->get_name() == npc->get_name();
+        });
+        ASSERT_NE(original, array.end());
+        EXPECT_EQ((*original)->get_type(), npc->get_type());
+        EXPECT_EQ((*original)->get_x(), npc->get_x());
+        EXPECT_EQ((*original)->get_y(), npc->get_y());
+    }
+
+    auto [low, high] = std::minmax_element(loaded.begin(), loaded.end(), [](const auto &a, const auto &b) {
+        return std::less<const NPC *>()(a.get(), b.get());
+    });
+    auto span = reinterpret_cast<std::uintptr_t>(high->get()) - reinterpret_cast<std::uintptr_t>(low->get());
+    EXPECT_LT(span, npc_arena_bytes(loaded.size()));
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(NPCTest, StreamingLoaderParsesChunksInParallel) {
+    const std::string filename = "test_stream.txt";
+    {
+        std::ofstream fs(filename);
+        fs << 500 << '\n';
+        for (int i = 0; i < 500; ++i) {
+            fs << (i % 3 + 1) << '\n' << i % 500 << '\n' << (i * 7) % 500 << '\n'
+               << "Npc_" << i << '\n';
+        }
+    }
+
+    std::vector<NpcEntry> entries;
+    std::vector<std::string> names;
+    auto result = stream_npcs(filename, [&](const NpcEntry &entry) {
+        entries.push_back(entry);
+        names.emplace_back(entry.name);
+    }, 4, 64);
+
+    EXPECT_EQ(result.expected, 500u);
+    EXPECT_EQ(result.loaded, 500u);
+    EXPECT_EQ(result.errors, 0u);
+    ASSERT_EQ(entries.size(), 500u);
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_EQ(entries[i].type, static_cast<NpcType>(i % 3 + 1));
+        EXPECT_EQ(entries[i].x, i % 500);
+        EXPECT_EQ(entries[i].y, (i * 7) % 500);
+        EXPECT_EQ(names[i], "Npc_" + std::to_string(i));
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(NPCTest, StreamingLoaderSkipsMalformedRecords) {
+    const std::string filename = "test_stream_bad.txt";
+    {
+        std::ofstream fs(filename);
+        fs << "4\n1 10 20 Good\n7 1 1 BadType\n2 x 5 BadCoord\n3 30 40 Last\n";
+    }
+
+    std::vector<std::string> names;
+    auto result = stream_npcs(filename, [&](const NpcEntry &entry) {
+        names.emplace_back(entry.name);
+    }, 2, 8);
+
+    EXPECT_EQ(result.loaded, 2u);
+    EXPECT_EQ(result.errors, 2u);
+    EXPECT_EQ(names, (std::vector<std::string>{"Good", "Last"}));
+
+    set_t loaded = load(filename);
+    EXPECT_EQ(loaded.size(), 2u);
+    EXPECT_EQ(loaded.count(nullptr), 0u);
+
+    std::remove(filename.c_str());
+}
+
+static void format_victim(std::string &out, const KillRecord &record) {
+    out += record.defender_name;
+    out += '\n';
+}
+
+TEST_F(NPCTest, LogSinkWritesEveryRecordOnFlush) {
+    std::stringstream out;
+    {
+        LogSink sink(out, format_victim, 16);
+        Squirrel killer(1, 2, "Killer");
+        Werewolf victim(3, 4, "Victim");
+
+        std::vector<std::thread> producers;
+        for (int t = 0; t < 4; ++t) {
+            producers.emplace_back([&]() {
+                for (int i = 0; i < 250; ++i) {
+                    sink.post(make_kill_record(killer, victim));
+                }
+            });
+        }
+        for (auto &t : producers) t.join();
+
+        sink.flush();
+        std::string line;
+        int lines = 0;
+        while (std::getline(out, line)) {
+            EXPECT_EQ(line, "Victim");
+            lines++;
+        }
+        EXPECT_EQ(lines, 1000);
+    }
+}
+
+TEST_F(NPCTest, JournalRoundTrip) {
+    const std::string filename = "test_journal.bin";
+    {
+        JournalWriter writer(filename);
+        std::vector<FightEvent> events(1000);
+        for (std::uint32_t i = 0; i < events.size(); ++i) {
+            events[i].tick = i / 10;
+            events[i].attacker_id = i;
+            events[i].defender_id = i + 1;
+            events[i].attacker_type = SquirrelType;
+            events[i].defender_type = WerewolfType;
+            events[i].attacker_x = -static_cast<int>(i);
+            events[i].outcome = i % 2 ? FightOutcome::Killed : FightOutcome::Missed;
+        }
+        writer.append(events.data(), events.size());
+        EXPECT_EQ(writer.count(), 1000u);
+    }
+
+    JournalReader reader(filename);
+    ASSERT_EQ(reader.size(), 1000u);
+    EXPECT_EQ(reader[999].tick, 99u);
+    EXPECT_EQ(reader[42].defender_id, 43u);
+    EXPECT_EQ(reader[42].attacker_x, -42);
+    EXPECT_EQ(reader[41].outcome, FightOutcome::Killed);
+    EXPECT_EQ(std::count_if(reader.begin(), reader.end(), [](const FightEvent &e) {
+        return e.outcome == FightOutcome::Killed;
+    }), 500);
+
+    std::remove(filename.c_str());
+    EXPECT_THROW(JournalReader("npcs_missing.bin"), std::runtime_error);
+}
+
+TEST_F(NPCTest, EventBusFiltersKillsAndDeliversBatches) {
+    auto kills = std::make_shared<MockObserver>();
+    auto id = EventBus::global().subscribe(EventKind::Kill, kills);
+
+    Squirrel squirrel(1, 1, "Squirrel1");
+    Werewolf werewolf(2, 2, "Werewolf1");
+    Druid druid(3, 3, "Druid1");
+    std::vector<FightNotice> batch = {
+        {&squirrel, &werewolf, true},
+        {&druid, &squirrel, false},
+        {&werewolf, &druid, true},
+    };
+    EventBus::global().publish(batch.data(), batch.size());
+
+    EXPECT_EQ(observer->notices, 3u);
+    EXPECT_EQ(kills->notices, 2u);
+    EXPECT_EQ(kills->last_attacker, &werewolf);
+
+    EventBus::global().unsubscribe(id);
+    EventBus::global().publish({&squirrel, &werewolf, true});
+    EXPECT_EQ(kills->notices, 2u);
+    EXPECT_EQ(observer->notices, 4u);
+}
+
+TEST_F(NPCTest, ConsoleLoggingSwitchKeepsFileLog) {
+    set_kill_logging(true);
+    set_console_logging(false);
+    auto killer = factory(WerewolfType, 1, 1, "FileOnlyWerewolf");
+    auto victim = factory(SquirrelType, 2, 2, "FileOnlySquirrel");
+    flush_logs();
+
+    std::ifstream before("log.txt", std::ios::binary | std::ios::ate);
+    std::streamoff start = before ? static_cast<std::streamoff>(before.tellg()) : 0;
+
+    testing::internal::CaptureStdout();
+    EventBus::global().publish({killer.get(), victim.get(), true});
+    flush_logs();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+
+    std::ifstream after("log.txt", std::ios::binary);
+    after.seekg(start);
+    std::string appended((std::istreambuf_iterator<char>(after)), std::istreambuf_iterator<char>());
+    EXPECT_NE(appended.find("FileOnlySquirrel"), std::string::npos);
+
+    set_kill_logging(false);
+}
+
+TEST_F(NPCTest, SnapshotsArePublishedWithoutDisturbingReaders) {
+    World world;
+    world.add(std::make_shared<Squirrel>(1, 2, "SnapSquirrel"));
+    world.add(std::make_shared<Druid>(3, 4, "SnapDruid"));
+
+    SnapshotBuffer buffer;
+    world.capture(buffer.begin_write(), 1);
+    buffer.publish();
+
+    auto first = buffer.acquire();
+    EXPECT_EQ(first->epoch, 1u);
+    EXPECT_EQ(first->alive, 2u);
+    EXPECT_EQ(first->alive_by_type[DruidType], 1u);
+
+    world.kill(0);
+    world.set_position(1, 9, 9);
+    for (std::uint64_t epoch = 2; epoch < 5; ++epoch) {
+        world.capture(buffer.begin_write(), epoch);
+        buffer.publish();
+    }
+
+    EXPECT_EQ(first->epoch, 1u);
+    EXPECT_EQ(first->xs[1], 3);
+    EXPECT_TRUE(first->alive_flags[0]);
+
+    auto latest = buffer.acquire();
+    EXPECT_EQ(latest->epoch, 4u);
+    EXPECT_EQ(latest->alive, 1u);
+    EXPECT_EQ(latest->xs[1], 9);
+    EXPECT_EQ(NameTable::global().get(latest->name_ids[1]), "SnapDruid");
+}
+
+TEST_F(NPCTest, RendererEmitsOnlyChangedCells) {
+    WorldSnapshot snapshot;
+    snapshot.xs = {5, 25, 1000};
+    snapshot.ys = {5, 15, 1000};
+    snapshot.types = {SquirrelType, DruidType, WerewolfType};
+    snapshot.alive_flags = {1, 1, 1};
+    snapshot.alive = 3;
+
+    Viewport view;
+    view.cols = 4;
+    view.rows = 3;
+    view.zoom = 10;
+    MapRenderer renderer(view);
+
+    std::string first = renderer.render(snapshot);
+    EXPECT_NE(first.find("\x1b[2J"), std::string::npos);
+    EXPECT_NE(first.find("\x1b[2;1HS..."), std::string::npos);
+    EXPECT_NE(first.find("\x1b[3;1H..D."), std::string::npos);
+    EXPECT_EQ(first.find('W'), std::string::npos);
+
+    EXPECT_TRUE(renderer.render(snapshot).empty());
+
+    snapshot.xs[1] = 35;
+    std::string diff = renderer.render(snapshot);
+    EXPECT_EQ(diff, "\x1b[3;3H.D\x1b[5;1H");
+
+    snapshot.alive_flags[0] = 0;
+    snapshot.alive = 2;
+    diff = renderer.render(snapshot);
+    EXPECT_NE(diff.find("Alive: 2"), std::string::npos);
+    EXPECT_NE(diff.find("\x1b[2;1H."), std::string::npos);
+}
+
+TEST_F(NPCTest, ParseViewport) {
+    const char *args[] = {"lab07", "--zoom", "50", "--viewport", "100,200,80,24"};
+    auto config = parse_args(5, const_cast<char **>(args));
+    EXPECT_EQ(config.viewport.zoom, 50);
+    EXPECT_EQ(config.viewport.x, 100);
+    EXPECT_EQ(config.viewport.y, 200);
+    EXPECT_EQ(config.viewport.cols, 80);
+    EXPECT_EQ(config.viewport.rows, 24);
+
+    const char *bad[] = {"lab07", "--viewport", "1,2,3"};
+    EXPECT_THROW(parse_args(3, const_cast<char **>(bad)), std::invalid_argument);
+}
+
+TEST_F(NPCTest, WorldCompactionKeepsOrderAndCounts) {
+    World world;
+    SpatialGrid grid(100, 10);
+    for (int i = 0; i < 6; ++i) {
+        NpcType type = i % 2 ? WerewolfType : SquirrelType;
+        auto index = world.add(factory(type, i * 10, 5, "Compact"));
+        grid.insert(index, world.x(index), world.y(index));
+    }
+    EXPECT_EQ(world.alive(), 6u);
+    EXPECT_EQ(world.alive(WerewolfType), 3u);
+
+    world.kill(1);
+    world.kill(1);
+    world.kill(4);
+    EXPECT_EQ(world.alive(), 4u);
+    EXPECT_EQ(world.alive(WerewolfType), 2u);
+    EXPECT_EQ(world.alive(SquirrelType), 2u);
+
+    std::vector<World::index_t> remap;
+    EXPECT_EQ(world.compact(remap), 2u);
+    grid.remap(remap);
+
+    ASSERT_EQ(world.size(), 4u);
+    EXPECT_EQ(world.dead(), 0u);
+    EXPECT_EQ(remap[1], World::INVALID_INDEX);
+    EXPECT_EQ(remap[5], 3u);
+    std::vector<std::uint32_t> ids;
+    for (World::index_t i = 0; i < world.size(); ++i) ids.push_back(world.id(i));
+    EXPECT_EQ(ids, (std::vector<std::uint32_t>{0, 2, 3, 5}));
+
+    std::vector<World::index_t> seen;
+    grid.for_each_near(50, 5, 60, [&](World::index_t i) { seen.push_back(i); });
+    EXPECT_EQ(seen, (std::vector<World::index_t>{0, 1, 2, 3}));
+}
+
+TEST_F(NPCTest, ArenaRecyclesReleasedNpcs) {
+    auto arena = std::make_shared<NpcArena>();
+    auto first = factory(DruidType, 1, 1, "Recycled", 500, arena);
+    const void *slot = first.get();
+    first.reset();
+
+    auto second = factory(DruidType, 2, 2, "Recycled", 500, arena);
+    EXPECT_EQ(second.get(), slot);
+    EXPECT_EQ(second->get_x(), 2);
+}
+
+TEST_F(NPCTest, MetricsHistogramAndExport) {
+    Histogram histogram;
+    for (int i = 0; i < 99; ++i) histogram.record_ns(3000);
+    histogram.record_ns(900000);
+
+    HistogramSnapshot h;
+    histogram.merge_into(h);
+    EXPECT_EQ(h.count, 100u);
+    EXPECT_EQ(h.percentile(0.5), 4u);
+    EXPECT_EQ(h.percentile(1.0), 1024u);
+
+    GameConfig config;
+    config.npc_count = 500;
+    config.headless = true;
+    config.seed = 11;
+    Game game(config);
+    for (int i = 0; i < 3; ++i) game.step();
+
+    auto m = game.collect_metrics();
+    EXPECT_EQ(m.ticks, 3u);
+    EXPECT_EQ(m.tick_time.count, 3u);
+    EXPECT_GT(m.fights_resolved, 0u);
+
+    std::string text = format_prometheus(m);
+    EXPECT_NE(text.find("lab07_ticks_total 3\n"), std::string::npos);
+    EXPECT_NE(text.find("lab07_lock_wait_seconds_total{lock=\"queue\"}"), std::string::npos);
+    EXPECT_EQ(text.find("lock=\"npcs\""), std::string::npos);
+    EXPECT_NE(format_json(m).find("\"ticks\": 3"), std::string::npos);
+
+    const std::string filename = "test_metrics.json";
+    MetricsExporter exporter(filename);
+    exporter.write(m);
+    std::ifstream in(filename);
+    std::string first;
+    std::getline(in, first);
+    EXPECT_EQ(first, "{");
+    std::remove(filename.c_str());
+}
+
+TEST_F(NPCTest, SchedulerCatchesUpAndSkips) {
+    using namespace std::chrono_literals;
+    auto origin = TickScheduler::clock::now();
+    TickScheduler scheduler(10ms, 3, origin);
+
+    EXPECT_EQ(scheduler.poll(origin), 1u);
+    EXPECT_EQ(scheduler.poll(origin + 5ms), 0u);
+    EXPECT_EQ(scheduler.next_deadline(), origin + 10ms);
+
+    EXPECT_EQ(scheduler.poll(origin + 25ms), 2u);
+    EXPECT_EQ(scheduler.skipped(), 0u);
+
+    // Ticks 3..10 are due; three run and the other five are dropped.
+    EXPECT_EQ(scheduler.poll(origin + 105ms), 3u);
+    EXPECT_EQ(scheduler.skipped(), 5u);
+    EXPECT_EQ(scheduler.next_deadline(), origin + 110ms);
+    EXPECT_EQ(scheduler.poll(origin + 109ms), 0u);
+}
+
+TEST_F(NPCTest, BatchRunsAreIndependentAndReproducible) {
+    GameConfig config;
+    config.map_size = 100;
+    config.npc_count = 200;
+    config.seed = 40;
+    config.turbo_ticks = 5;
+    config.batch_runs = 6;
+
+    size_t global_names = NameTable::global().size();
+    config.threads = 1;
+    auto serial = run_batch(config);
+    config.threads = 4;
+    auto parallel = run_batch(config);
+
+    ASSERT_EQ(serial.size(), 6u);
+    ASSERT_EQ(parallel.size(), 6u);
+    for (size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i].seed, 40u + i);
+        EXPECT_EQ(serial[i].ticks, 5u);
+        EXPECT_GT(serial[i].fights, 0u);
+        EXPECT_EQ(serial[i].fights, parallel[i].fights);
+        for (NpcType type : {SquirrelType, WerewolfType, DruidType}) {
+            EXPECT_EQ(serial[i].survivors[type], parallel[i].survivors[type]);
+        }
+        EXPECT_EQ(serial[i].total, parallel[i].total);
+    }
+
+    config.batch_runs = 1;
+    config.seed = 43;
+    auto replay = run_batch(config);
+    EXPECT_EQ(NameTable::global().size(), global_names);
+    EXPECT_EQ(replay[0].fights, serial[3].fights);
+    EXPECT_EQ(replay[0].total, serial[3].total);
+
+    auto stats = summarize(serial);
+    ASSERT_EQ(stats.size(), 3u);
+    EXPECT_LE(stats[0].min, stats[0].p50);
+    EXPECT_LE(stats[0].p50, stats[0].max);
+
+    std::ostringstream runs, summary;
+    write_runs_csv(runs, serial);
+    write_summary_csv(summary, stats);
+    EXPECT_EQ(runs.str().rfind("run,seed,ticks,fights,squirrel,werewolf,druid,total\n0,40,5,", 0), 0u);
+    EXPECT_EQ(summary.str().rfind("species,mean,", 0), 0u);
+    EXPECT_NE(summary.str().find("\ndruid,"), std::string::npos);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,226 @@
+#include "journal.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+static const int TYPE_COUNT = 4;
+static const char *TYPE_NAMES[TYPE_COUNT] = {"Unknown", "Squirrel", "Werewolf", "Druid"};
+
+struct Filter {
+    std::uint32_t tick_from = 0;
+    std::uint32_t tick_to = UINT32_MAX;
+    std::int64_t attacker = -1;
+    std::int64_t defender = -1;
+    int type = -1;
+    bool kills_only = false;
+
+    bool matches(const FightEvent &e) const {
+        if (e.tick < tick_from || e.tick > tick_to) return false;
+        if (attacker >= 0 && e.attacker_id != attacker) return false;
+        if (defender >= 0 && e.defender_id != defender) return false;
+        if (type >= 0 && e.attacker_type != type && e.defender_type != type) return false;
+        if (kills_only && e.outcome != FightOutcome::Killed) return false;
+        return true;
+    }
+};
+
+struct Stats {
+    std::uint64_t matched = 0;
+    std::uint64_t by_outcome[3] = {};
+    std::uint64_t kills_by_type[TYPE_COUNT] = {};
+    std::uint64_t fights[TYPE_COUNT][TYPE_COUNT] = {};
+    std::uint32_t first_tick = UINT32_MAX;
+    std::uint32_t last_tick = 0;
+
+    void add(const FightEvent &e) {
+        matched++;
+        by_outcome[static_cast<int>(e.outcome) % 3]++;
+        int a = e.attacker_type % TYPE_COUNT;
+        int d = e.defender_type % TYPE_COUNT;
+        fights[a][d]++;
+        if (e.outcome == FightOutcome::Killed) kills_by_type[a]++;
+        if (e.tick < first_tick) first_tick = e.tick;
+        if (e.tick > last_tick) last_tick = e.tick;
+    }
+
+    void merge(const Stats &other) {
+        matched += other.matched;
+        for (int i = 0; i < 3; ++i) by_outcome[i] += other.by_outcome[i];
+        for (int a = 0; a < TYPE_COUNT; ++a) {
+            kills_by_type[a] += other.kills_by_type[a];
+            for (int d = 0; d < TYPE_COUNT; ++d) fights[a][d] += other.fights[a][d];
+        }
+        if (other.first_tick < first_tick) first_tick = other.first_tick;
+        if (other.last_tick > last_tick) last_tick = other.last_tick;
+    }
+};
+
+static std::uint64_t parse_value(const std::string &flag, const std::string &value) {
+    size_t used = 0;
+    unsigned long long result = 0;
+    try {
+        result = std::stoull(value, &used);
+    } catch (const std::exception &) {
+        used = 0;
+    }
+    if (used != value.size()) {
+        throw std::invalid_argument("Invalid value for " + flag + ": " + value);
+    }
+    return result;
+}
+
+static int parse_type(const std::string &value) {
+    for (int t = 1; t < TYPE_COUNT; ++t) {
+        if (value == TYPE_NAMES[t]) return t;
+    }
+    throw std::invalid_argument("Unknown NPC type: " + value);
+}
+
+static Filter parse_filter(int argc, char *argv[], int first) {
+    Filter filter;
+    for (int i = first; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--kills-only") {
+            filter.kills_only = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Unknown option or missing value: " + arg);
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--tick-from") {
+            filter.tick_from = static_cast<std::uint32_t>(parse_value(arg, value));
+        } else if (arg == "--tick-to") {
+            filter.tick_to = static_cast<std::uint32_t>(parse_value(arg, value));
+        } else if (arg == "--attacker") {
+            filter.attacker = static_cast<std::int64_t>(parse_value(arg, value));
+        } else if (arg == "--defender") {
+            filter.defender = static_cast<std::int64_t>(parse_value(arg, value));
+        } else if (arg == "--type") {
+            filter.type = parse_type(value);
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    return filter;
+}
+
+static void dump(const JournalReader &journal, const Filter &filter) {
+    std::string out;
+    out.reserve(1 << 20);
+
+    for (const auto &e : journal) {
+        if (!filter.matches(e)) continue;
+
+        out += std::to_string(e.tick);
+        out += ' ';
+        out += TYPE_NAMES[e.attacker_type % TYPE_COUNT];
+        out += '#';
+        out += std::to_string(e.attacker_id);
+        out += " (";
+        out += std::to_string(e.attacker_x);
+        out += ", ";
+        out += std::to_string(e.attacker_y);
+        out += ") -> ";
+        out += TYPE_NAMES[e.defender_type % TYPE_COUNT];
+        out += '#';
+        out += std::to_string(e.defender_id);
+        out += " (";
+        out += std::to_string(e.defender_x);
+        out += ", ";
+        out += std::to_string(e.defender_y);
+        out += ") ";
+        out += std::to_string(e.attack_roll);
+        out += ':';
+        out += std::to_string(e.defense_roll);
+        out += ' ';
+        out += outcome_name(e.outcome);
+        out += '\n';
+
+        if (out.size() >= (1 << 20)) {
+            std::cout << out;
+            out.clear();
+        }
+    }
+    std::cout << out;
+}
+
+static void stats(const JournalReader &journal, const Filter &filter) {
+    ThreadPool pool;
+    size_t chunks = pool.size() * 4;
+    size_t per_chunk = (journal.size() + chunks - 1) / chunks;
+    std::vector<Stats> partial(chunks);
+
+    pool.run(chunks, [&](size_t c) {
+        size_t first = std::min(journal.size(), c * per_chunk);
+        size_t last = std::min(journal.size(), first + per_chunk);
+        for (size_t i = first; i < last; ++i) {
+            if (filter.matches(journal[i])) partial[c].add(journal[i]);
+        }
+    });
+
+    Stats total;
+    for (const auto &s : partial) total.merge(s);
+
+    std::cout << "Events: " << journal.size() << ", matched: " << total.matched << std::endl;
+    if (total.matched == 0) return;
+
+    std::cout << "Ticks: " << total.first_tick << " - " << total.last_tick << std::endl;
+    for (int o = 0; o < 3; ++o) {
+        std::cout << outcome_name(static_cast<FightOutcome>(o)) << ": " << total.by_outcome[o] << std::endl;
+    }
+
+    std::cout << "\nKills by species:" << std::endl;
+    for (int t = 1; t < TYPE_COUNT; ++t) {
+        std::cout << TYPE_NAMES[t] << ": " << total.kills_by_type[t] << std::endl;
+    }
+
+    std::cout << "\nFights (attacker x defender):" << std::endl;
+    for (int a = 1; a < TYPE_COUNT; ++a) {
+        std::cout << TYPE_NAMES[a] << ":";
+        for (int d = 1; d < TYPE_COUNT; ++d) {
+            std::cout << " " << TYPE_NAMES[d] << "=" << total.fights[a][d];
+        }
+        std::cout << std::endl;
+    }
+}
+
+static std::string usage() {
+    return "Usage: lab07_journal dump|stats JOURNAL [--tick-from N] [--tick-to N]\n"
+           "                     [--attacker ID] [--defender ID]\n"
+           "                     [--type Squirrel|Werewolf|Druid] [--kills-only]";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << usage() << std::endl;
+        return 1;
+    }
+
+    std::string command = argv[1];
+
+    try {
+        Filter filter = parse_filter(argc, argv, 3);
+        JournalReader journal(argv[2]);
+
+        if (command == "dump") {
+            dump(journal, filter);
+        } else if (command == "stats") {
+            stats(journal, filter);
+        } else {
+            std::cerr << "Unknown command: " << command << std::endl << usage() << std::endl;
+            return 1;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file